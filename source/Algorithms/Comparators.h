@@ -2,6 +2,7 @@
 #define COMPARATORS_H
 
 #include "../DataHandling/LandUnitData.h"
+#include "../DataHandling/YearIndex.h"
 
 namespace Algorithms {
 
@@ -30,8 +31,8 @@ namespace Algorithms {
 		const Category category_;
 
 	public:
-		static ComparePopulation InYear(const size_t year, const Category category) {
-			return {2020 - year, category};
+		static ComparePopulation InYear(const DataHandling::YearIndex& years, const int year, const Category category) {
+			return {years.index_of(year), category};
 		};
 		ComparePopulation(const size_t index, const Category category) : index_(index), category_(category) {};
 		int operator()(const DataHandling::LandUnitData& left, const DataHandling::LandUnitData& right) const;
@@ -6,8 +6,8 @@ bool Algorithms::ContainsSubstringInName::operator()(DataHandling::LandUnitData&
 }
 
 
-Algorithms::HasMaxResidents Algorithms::HasMaxResidents::InYear(const size_t year, const int limit_) {
-	return HasMaxResidents(2020 - year, limit_);
+Algorithms::HasMaxResidents Algorithms::HasMaxResidents::InYear(const DataHandling::YearIndex& years, const int year, const int limit_) {
+	return HasMaxResidents(years.index_of(year), limit_);
 }
 
 bool Algorithms::HasMaxResidents::operator()(const DataHandling::LandUnitData& landUnitData) const {
@@ -17,8 +17,8 @@ bool Algorithms::HasMaxResidents::operator()(const DataHandling::LandUnitData& l
 
 
 
-Algorithms::HasMinResidents Algorithms::HasMinResidents::InYear(const size_t year, const int limit_) {
-	return HasMinResidents(2020 - year, limit_);
+Algorithms::HasMinResidents Algorithms::HasMinResidents::InYear(const DataHandling::YearIndex& years, const int year, const int limit_) {
+	return HasMinResidents(years.index_of(year), limit_);
 }
 
 bool Algorithms::HasMinResidents::operator()(const DataHandling::LandUnitData& landUnitData) const {
@@ -5,6 +5,7 @@
 #include <utility>
 
 #include "../DataHandling/LandUnitData.h"
+#include "../DataHandling/YearIndex.h"
 
 namespace Algorithms {
 	class ContainsSubstringInName {
@@ -26,7 +27,7 @@ namespace Algorithms {
 		const int limit_;
 
 	public:
-		static HasMaxResidents InYear(const size_t year, const int limit_);
+		static HasMaxResidents InYear(const DataHandling::YearIndex& years, const int year, const int limit_);
 
 		explicit HasMaxResidents(const size_t index, const int limit) : index_(index), limit_(limit) {}
 		bool operator()(const DataHandling::LandUnitData& landUnitData) const;
@@ -43,7 +44,7 @@ namespace Algorithms {
 		const int limit_;
 
 	public:
-		static HasMinResidents InYear(const size_t year, const int limit_);
+		static HasMinResidents InYear(const DataHandling::YearIndex& years, const int year, const int limit_);
 
 		explicit HasMinResidents(const size_t index, const int limit) : index_(index), limit_(limit) {}
 		bool operator()(const DataHandling::LandUnitData& landUnitData) const;
@@ -0,0 +1,242 @@
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "../Containers/ArenaAllocator.h"
+#include "../Containers/ArrayList.h"
+#include "../Containers/FlatTable.h"
+#include "../Containers/LinkedList.h"
+#include "../Containers/LinkedTable.h"
+
+#include "../DataHandling/CsvLineReader.h"
+#include "../DataHandling/MappedFile.h"
+
+/*
+ * Compares lookup latency of LinkedTable and FlatTable on names of real land units, or on generated names.
+ * Both tables are configured exactly like tables of DataHolder (string_view keys, arena allocator, default hash).
+ * LinkedTable is measured with std::hash too, so default string hash can be compared with it.
+ *
+ * usage: table_benchmark [data directory] (default is ../../data, same as main_app)
+ *        table_benchmark --synthetic [key count] (default is 400000 generated town-like names)
+ */
+
+using ClockType = std::chrono::steady_clock;
+
+// every key is looked up this many times in each measurement
+constexpr size_t LOOKUP_ROUNDS = 200;
+
+// synthetic keys are much more numerous, so they are looked up fewer times
+constexpr size_t SYNTHETIC_LOOKUP_ROUNDS = 5;
+constexpr size_t SYNTHETIC_KEY_COUNT = 400000;
+
+const char* const USAGE = "usage: table_benchmark [data directory] | table_benchmark --synthetic [key count]";
+
+template<typename ItemType>
+using ArenaAllocatorType = Containers::ArenaAllocator<ItemType>;
+
+/**
+ * Reads first field (name) of every line of csv file into list
+ */
+void read_names_(const DataHandling::MappedFile& file, Containers::LinkedList<std::string_view>& names) {
+	for (auto line : file.lines()) {
+		DataHandling::CsvLineReader(line)
+			.handleField([&names](std::string_view field) {
+				names.push_back(field);
+			});
+	}
+}
+
+/**
+ * Reads unique names of units from uzemie.csv and obce.csv in data directory
+ */
+void read_unique_names_(const std::string& data_directory, Containers::ArrayList<std::string>& unique_names) {
+	auto regions_file = DataHandling::MappedFile(data_directory + "/uzemie.csv");
+	auto towns_file = DataHandling::MappedFile(data_directory + "/obce.csv");
+
+	Containers::LinkedList<std::string_view> names;
+	read_names_(regions_file, names);
+	read_names_(towns_file, names);
+
+	// tables need unique keys - there are more towns with same name
+	Containers::Arena unique_arena;
+	Containers::LinkedTable<std::string_view, size_t, ArenaAllocatorType<std::pair<const std::string_view, size_t>>> inserted_names(unique_arena);
+
+	for (auto name : names) {
+		if (inserted_names.try_insert(name, unique_names.size()) != nullptr) {
+			unique_names.push_back(std::string(name));
+		}
+	}
+}
+
+/**
+ * Generates unique names that look like names of towns (Steinbachdorf 1234) - they share prefixes and suffixes
+ * like real names, number makes every name unique
+ */
+void generate_names_(Containers::ArrayList<std::string>& names, const size_t count) {
+	static const char* const SYLLABLES[] = {"Stein", "bach", "dorf", "Berg", "kirchen", "au", "Feld", "hof", "wald", "see", "Neu", "markt"};
+	constexpr size_t SYLLABLE_COUNT = sizeof(SYLLABLES) / sizeof(SYLLABLES[0]);
+
+	names.reserve(count);
+
+	uint64_t state = 0x9E3779B97F4A7C15ull;
+	for (size_t index = 0; index < count; ++index) {
+		std::string name;
+
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		auto syllable_count = 2 + static_cast<size_t>((state >> 33) % 3);
+		for (size_t syllable = 0; syllable < syllable_count; ++syllable) {
+			name += SYLLABLES[(state >> (8 * syllable + 5)) % SYLLABLE_COUNT];
+		}
+
+		name += " ";
+		name += std::to_string(index);
+		names.push_back(std::move(name));
+	}
+}
+
+/**
+ * Creates deterministic permutation of indexes <0, count), so lookups don't follow order of insertion
+ */
+void shuffle_indexes_(Containers::ArrayList<size_t>& order, const size_t count) {
+	for (size_t index = 0; index < count; ++index) {
+		order[index] = index;
+	}
+
+	// nothing to shuffle
+	if (count < 2) {
+		return;
+	}
+
+	uint64_t state = 0x2545F4914F6CDD1Dull;
+	for (size_t index = count - 1; index > 0; --index) {
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		auto other = static_cast<size_t>((state >> 33) % (index + 1));
+
+		auto swapped = order[index];
+		order[index] = order[other];
+		order[other] = swapped;
+	}
+}
+
+/**
+ * Returns average time of one lookup in nanoseconds
+ */
+template<typename TableType, typename KeyListType>
+double measure_lookups_(TableType& table, KeyListType& keys, Containers::ArrayList<size_t>& order, const size_t count, const size_t rounds, size_t& checksum) {
+	auto start = ClockType::now();
+
+	for (size_t round = 0; round < rounds; ++round) {
+		for (size_t index = 0; index < count; ++index) {
+			auto value = table.find(std::string_view(keys[order[index]]));
+			checksum += (value == nullptr) ? 1 : *value;
+		}
+	}
+
+	auto elapsed = std::chrono::duration<double, std::nano>(ClockType::now() - start).count();
+	return elapsed / static_cast<double>(rounds * count);
+}
+
+template<typename TableType>
+void run_benchmark_(
+	const char* label,
+	Containers::ArrayList<std::string_view>& keys,
+	Containers::ArrayList<std::string>& missing_keys,
+	Containers::ArrayList<size_t>& order,
+	const size_t count,
+	const size_t rounds
+) {
+	Containers::Arena arena;
+	size_t checksum = 0;
+
+	auto build_start = ClockType::now();
+
+	TableType table = TableType(ArenaAllocatorType<std::pair<const std::string_view, size_t>>(arena));
+	for (size_t index = 0; index < count; ++index) {
+		table.insert(keys[index], index);
+	}
+
+	auto build_time = std::chrono::duration<double, std::micro>(ClockType::now() - build_start).count();
+
+	auto hit_time = measure_lookups_(table, keys, order, count, rounds, checksum);
+	auto miss_time = measure_lookups_(table, missing_keys, order, count, rounds, checksum);
+
+	std::cout << label
+		<< " | build " << build_time << " us"
+		<< " | hit " << hit_time << " ns"
+		<< " | miss " << miss_time << " ns"
+		<< " | arena " << arena.allocated_bytes() << " B"
+		<< " | checksum " << checksum << std::endl;
+}
+
+int main(int argument_count, char** arguments) {
+	const bool synthetic = argument_count > 1 && std::string_view(arguments[1]) == "--synthetic";
+
+	// owns text of every key - keys are views into it, like keys of DataHolder tables are views into its string pool
+	Containers::ArrayList<std::string> names;
+	size_t rounds = LOOKUP_ROUNDS;
+
+	if (synthetic) {
+		size_t key_count = SYNTHETIC_KEY_COUNT;
+
+		if (argument_count > 2) {
+			std::string_view argument = arguments[2];
+			auto result = std::from_chars(argument.data(), argument.data() + argument.size(), key_count);
+
+			if (result.ec != std::errc() || result.ptr != argument.data() + argument.size()) {
+				std::cerr << USAGE << std::endl;
+				return 1;
+			}
+		}
+
+		generate_names_(names, key_count);
+		rounds = SYNTHETIC_LOOKUP_ROUNDS;
+	}
+	else {
+		try {
+			read_unique_names_((argument_count > 1) ? arguments[1] : "../../data", names);
+		}
+		catch (std::runtime_error& e) {
+			std::cerr << e.what() << std::endl << USAGE << std::endl;
+			return 1;
+		}
+	}
+
+	const size_t count = names.size();
+	if (count == 0) {
+		std::cerr << "No keys to measure." << std::endl;
+		return 1;
+	}
+
+	Containers::ArrayList<std::string_view> keys(count, std::string_view());
+	Containers::ArrayList<std::string> missing_keys(count, std::string());
+
+	for (size_t index = 0; index < count; ++index) {
+		keys[index] = names[index];
+
+		// same length as real key and differs only in last character, so misses have to compare characters too
+		missing_keys[index] = names[index].empty() ? std::string("#") : names[index];
+		missing_keys[index].back() = '#';
+	}
+
+	Containers::ArrayList<size_t> order(count, 0);
+	shuffle_indexes_(order, count);
+
+	std::cout << "keys : " << count << ", lookups per measurement : " << rounds * count << std::endl;
+
+	for (int repetition = 0; repetition < 3; ++repetition) {
+		run_benchmark_<Containers::LinkedTable<std::string_view, size_t, ArenaAllocatorType<std::pair<const std::string_view, size_t>>, std::hash<std::string_view>>>(
+			"LinkedTable (std::hash)", keys, missing_keys, order, count, rounds
+		);
+		run_benchmark_<Containers::LinkedTable<std::string_view, size_t, ArenaAllocatorType<std::pair<const std::string_view, size_t>>>>(
+			"LinkedTable            ", keys, missing_keys, order, count, rounds
+		);
+		run_benchmark_<Containers::FlatTable<std::string_view, size_t, ArenaAllocatorType<std::pair<const std::string_view, size_t>>>>(
+			"FlatTable              ", keys, missing_keys, order, count, rounds
+		);
+	}
+
+	return 0;
+}
@@ -6,6 +6,7 @@
 #include "Algorithms/Comparators.h"
 
 #include "DataHandling/LandUnitData.h"
+#include "Containers/ArrayList.h"
 #include "Containers/NodeBasedTree.h"
 
 
@@ -15,7 +16,7 @@
 
 void print_land_unit(DataHandling::LandUnitData* land_unit) {
 	std::cout << land_unit->get_name() << " [ " << land_unit->get_identifier()  << " ] | ";
-	for (size_t index = 0; index < DataHandling::LAND_UNIT_POPULATION_COUNT; ++index) {
+	for (size_t index = 0; index < land_unit->get_population_years().size(); ++index) {
 		std::cout << " ( " <<  land_unit->male_population_at(index) << " : " << land_unit->female_population_at(index) << " ) ";
  	};
 	std::cout << std::endl;
@@ -42,6 +43,30 @@ int request_choice_input(std::initializer_list<int> valid_choices) {
 	};
 };
 
+int request_year_input(const DataHandling::YearIndex& years) {
+	std::cout << "Zadaj rok [";
+	if (years.is_continuous()) {
+		std::cout << years.first_year() << "-" << years.last_year();
+	}
+	else {
+		// some years are missing - list only those which can be chosen
+		for (size_t index = 0; index < years.size(); ++index) {
+			std::cout << (index == 0 ? "" : ", ") << years.year_at(index);
+		}
+	}
+	std::cout << "]" << std::endl;
+
+	while (true) {
+		int year = request_choice_input({});
+
+		if (years.contains(year)) {
+			return year;
+		}
+
+		std::cout << "Neznáma volba : " << year << std::endl;
+	};
+};
+
 void ConsoleEnvironment::show_main_menu() {
 	int choice = -1;
 
@@ -49,9 +74,11 @@ void ConsoleEnvironment::show_main_menu() {
 		std::cout << "== MENU ==" << std::endl;
 		std::cout << "[2] nástroje stromu uzemných jednotiek" << std::endl;
 		std::cout << "[3] tabulky uzemných jednotiek" << std::endl;
+		std::cout << "[4] report načítania dát" << std::endl;
+		std::cout << "[5] report načítania dát (JSON)" << std::endl;
 		std::cout << "[0] koniec" << std::endl;
 
-		choice = request_choice_input({0,2,3});
+		choice = request_choice_input({0,2,3,4,5});
 		switch (choice) {
 			case 0: {
 				std::cout << "Ukončenie programu" << std::endl;
@@ -66,6 +93,14 @@ void ConsoleEnvironment::show_main_menu() {
 				this->show_tables_menu();
 				break;
 			};
+			case 4: {
+				this->holder_.get_load_report().print(std::cout);
+				break;
+			};
+			case 5: {
+				this->holder_.get_load_report().write_json(std::cout);
+				break;
+			};
 
 			default: {
 				std::cout << "Neznáma volba : " << choice << std::endl;
@@ -78,10 +113,11 @@ void ConsoleEnvironment::show_main_menu() {
 
 
 
-using TreeIterator = Containers::TreeNode<DataHandling::LandUnitData*>::Iterator;
+// selection goes only through units of subtree of chosen unit, collected level by level
+using SubtreeIterator = Containers::ArrayList<DataHandling::LandUnitData*>::Iterator;
 
-void show_selection_submenu(TreeIterator& begin, TreeIterator& end) {
-	Containers::LinkedList<DataHandling::LandUnitData*> output_list;
+void show_selection_submenu(SubtreeIterator& begin, SubtreeIterator& end, const DataHandling::YearIndex& years) {
+	Containers::ArrayList<DataHandling::LandUnitData*> output_list;
 	int choice = -1;
 
 	std::cout << "== SELEKCIA ==" << std::endl;
@@ -111,23 +147,21 @@ void show_selection_submenu(TreeIterator& begin, TreeIterator& end) {
 			break;
 		};
 		case 2: {
-			std::cout << "Zadaj rok [2020-2024]" << std::endl;
-			int year = request_choice_input({2020, 2021, 2022, 2023, 2024});
+			int year = request_year_input(years);
 
 			std::cout << "Zadaj limit" << std::endl;
 			int limit = request_choice_input({});
 
-			Algorithms::select(begin, end, output_list.push_backer(), Algorithms::HasMaxResidents::InYear(year, limit));
+			Algorithms::select(begin, end, output_list.push_backer(), Algorithms::HasMaxResidents::InYear(years, year, limit));
 			break;
 		}
 		case 3: {
-			std::cout << "Zadaj rok [2020-2024]" << std::endl;
-			int year = request_choice_input({2020, 2021, 2022, 2023, 2024});
+			int year = request_year_input(years);
 
 			std::cout << "Zadaj limit" << std::endl;
 			int limit = request_choice_input({});
 
-			Algorithms::select(begin, end, output_list.push_backer(), Algorithms::HasMinResidents::InYear(year, limit));
+			Algorithms::select(begin, end, output_list.push_backer(), Algorithms::HasMinResidents::InYear(years, year, limit));
 			break;
 		}
 		case 4: {
@@ -162,13 +196,12 @@ void show_selection_submenu(TreeIterator& begin, TreeIterator& end) {
 			break;
 		};
 		case 1: {
-			std::cout << "Zadaj rok [2020-2024]" << std::endl;
-			int year = request_choice_input({2020, 2021, 2022, 2023, 2024});
+			int year = request_year_input(years);
 
 			std::cout << "Zadaj kategoriu [0 - muži, 1 - ženy, 2 - všetci]:" << std::endl;
 			auto category = static_cast<Algorithms::ComparePopulation::Category>( request_choice_input({0,1,2}) );
 
-			Algorithms::quick_sort(output_list.begin(), output_list.end(), Algorithms::ComparePopulation::InYear(year, category));
+			Algorithms::quick_sort(output_list.begin(), output_list.end(), Algorithms::ComparePopulation::InYear(years, year, category));
 			break;
 		};
 	};
@@ -182,7 +215,6 @@ void show_selection_submenu(TreeIterator& begin, TreeIterator& end) {
 
 void ConsoleEnvironment::show_tree_menu() {
 	auto tree_iterator = this->holder_.get_tree_iterator();
-	auto tree_iterator_end = this->holder_.root_node_.end();
 	int choice = -1;
 
 	while (true) {
@@ -220,12 +252,12 @@ void ConsoleEnvironment::show_tree_menu() {
 				std::cin >> target_name;
 				std::cout << std::endl;
 
-				auto ok = tree_iterator.move_to_children([&target_name](auto& land_unit) {
-					return land_unit.get_item()->get_name() == target_name;
-				});
+				auto ok = DataHandling::DataHolder::move_to_children_by_name(tree_iterator, target_name);
 
 				if (ok) { std::cout << "Iterátor sa úspešne preniesol na dieťa" << std::endl; }
 				else { std::cout << "Dieťa z daným reťazcom v mene neexistuje." << std::endl; }
+
+				break;
 			};
 
 
@@ -235,12 +267,12 @@ void ConsoleEnvironment::show_tree_menu() {
 				std::cin >> target_id;
 				std::cout << std::endl;
 
-				auto ok = tree_iterator.move_to_children([&target_id](auto child_land) {
-					return child_land.get_item()->get_identifier() == target_id;
-				});
+				auto ok = DataHandling::DataHolder::move_to_children_by_id(tree_iterator, target_id);
 
 				if (ok) { std::cout << "Iterátor sa úspešne preniesol na dieťa" << std::endl; }
 				else { std::cout << "Dieťa z id neexistuje" << std::endl; }
+
+				break;
 			}
 
 			case 4: {
@@ -249,7 +281,15 @@ void ConsoleEnvironment::show_tree_menu() {
 			};
 
 			case 5: {
-				show_selection_submenu(tree_iterator, tree_iterator_end);
+				Containers::ArrayList<DataHandling::LandUnitData*> subtree_units;
+				tree_iterator.get_node()->for_each_in_level_order([&subtree_units](DataHandling::LandUnitData* land_unit) {
+					subtree_units.push_back(land_unit);
+				});
+
+				auto subtree_begin = subtree_units.begin();
+				auto subtree_end = subtree_units.end();
+
+				show_selection_submenu(subtree_begin, subtree_end, this->holder_.get_population_years());
 				break;
 			} ;
 
@@ -272,14 +312,20 @@ void ConsoleEnvironment::show_tables_menu() {
 
 
 		std::cout << "Vyber level administrativnej jednotky (1-4)" << std::endl;
+		std::cout << "[5] hľadanie podľa kódu jednotky (<AT111>, AT111, <10801>...)" << std::endl;
 		std::cin.clear();
-		table_number = request_choice_input({1,2,3,4});
+		table_number = request_choice_input({1,2,3,4,5});
 
 
 		std::string table_unit_name;
 
 		std::cout << std::endl;
-		std::cout << "Vyber meno vyhladávanej administratívnej jednotky" << std::endl;
+		if (table_number == 5) {
+			std::cout << "Vyber kód vyhladávanej administratívnej jednotky" << std::endl;
+		}
+		else {
+			std::cout << "Vyber meno vyhladávanej administratívnej jednotky" << std::endl;
+		}
 		std::cout << ":: ";
 		std::cin.ignore();
 		std::getline(std::cin, table_unit_name);
@@ -305,13 +351,22 @@ void ConsoleEnvironment::show_tables_menu() {
 
 				};
 				case 4: {
-					auto result = this->holder_.towns_table_.at(table_unit_name);
+					auto& result = this->holder_.towns_table_.at(table_unit_name);
 					for (auto& one_town : result) {
 						print_land_unit(one_town);
 						std::cout << std::endl;
 					}
 					break;
 				};
+				case 5: {
+					const auto result = this->holder_.find_unit_by_code(table_unit_name);
+					if (result == nullptr) {
+						std::cout << "Jednotka z daným kódom neexistuje" << std::endl;
+						break;
+					}
+					print_land_unit(result);
+					break;
+				};
 				default: {
 					throw std::runtime_error("This isn't allowed");
 				};
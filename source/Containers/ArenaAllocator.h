@@ -0,0 +1,191 @@
+#ifndef ARENAALLOCATOR_H
+#define ARENAALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace Containers {
+	/**
+	 * Owns large blocks of memory and hands out pieces of them (bump allocation).
+	 * Pieces are never returned one by one - every block is released at once when arena is released or destroyed.
+	 *
+	 * NOTE: arena is not thread safe
+	 */
+	class Arena {
+		struct Block {
+			Block* previous = nullptr;
+		};
+
+		Block* current_block_ = nullptr;
+		char* position_ = nullptr;
+		char* end_ = nullptr;
+
+		size_t block_size_;
+
+		// statistics
+		size_t allocation_count_ = 0;
+		size_t block_count_ = 0;
+		size_t allocated_bytes_ = 0;
+
+		static char* align_(char* position, const size_t alignment) {
+			auto address = reinterpret_cast<std::uintptr_t>(position);
+			auto aligned = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+
+			return position + (aligned - address);
+		}
+
+		/**
+		 * Allocates new block which can hold at least minimal_size bytes and makes it current
+		 */
+		void add_block_(const size_t minimal_size) {
+			size_t data_size = (minimal_size > this->block_size_) ? minimal_size : this->block_size_;
+
+			auto memory = static_cast<char*>(::operator new(sizeof(Block) + data_size));
+			auto block = new (memory) Block();
+
+			block->previous = this->current_block_;
+			this->current_block_ = block;
+
+			this->position_ = memory + sizeof(Block);
+			this->end_ = this->position_ + data_size;
+
+			++this->block_count_;
+		}
+
+	public:
+		/**
+		 * Creates empty arena. No memory is allocated until first request.
+		 *
+		 * \param block_size : size of blocks requested from system (larger requests get their own block)
+		 */
+		explicit Arena(const size_t block_size = 64 * 1024) : block_size_(block_size) {}
+
+		Arena(const Arena& other) = delete;
+		Arena& operator=(const Arena& other) = delete;
+
+		~Arena() {
+			this->release();
+		}
+
+		/**
+		 * Returns piece of memory with requested size and alignment
+		 */
+		void* allocate(const size_t size, const size_t alignment) {
+			char* address = align_(this->position_, alignment);
+
+			if (this->current_block_ == nullptr || address + size > this->end_) {
+				this->add_block_(size + alignment);
+				address = align_(this->position_, alignment);
+			}
+
+			this->position_ = address + size;
+
+			++this->allocation_count_;
+			this->allocated_bytes_ += size;
+
+			return address;
+		}
+
+		/**
+		 * Releases every block at once. Everything allocated from arena becomes invalid.
+		 */
+		void release() {
+			while (this->current_block_ != nullptr) {
+				auto previous = this->current_block_->previous;
+
+				this->current_block_->~Block();
+				::operator delete(static_cast<void*>(this->current_block_));
+
+				this->current_block_ = previous;
+			}
+
+			this->position_ = nullptr;
+			this->end_ = nullptr;
+		}
+
+		/**
+		 * Returns number of pieces handed out by arena
+		 */
+		size_t allocation_count() const {
+			return this->allocation_count_;
+		}
+
+		/**
+		 * Returns number of blocks requested from system
+		 */
+		size_t block_count() const {
+			return this->block_count_;
+		}
+
+		/**
+		 * Returns number of bytes handed out by arena
+		 */
+		size_t allocated_bytes() const {
+			return this->allocated_bytes_;
+		}
+	};
+
+
+	/**
+	 * Allocator which takes memory from arena. Deallocation does nothing - memory is released together with arena.
+	 * Every container of Containers can use it as its AllocatorType, but it has to be passed to them (it has no default state).
+	 *
+	 * \tparam ItemType : type of allocated objects
+	 */
+	template<typename ItemType>
+	class ArenaAllocator {
+		Arena* arena_;
+
+	public:
+		using value_type = ItemType;
+
+		// containers don't have to return their nodes - whole arena is released at once
+		using releases_in_bulk = std::true_type;
+
+		ArenaAllocator(Arena& arena) noexcept : arena_(&arena) {}
+
+		template<typename OtherType>
+		ArenaAllocator(const ArenaAllocator<OtherType>& other) noexcept : arena_(other.arena()) {}
+
+		ItemType* allocate(const size_t count) {
+			return static_cast<ItemType*>(this->arena_->allocate(sizeof(ItemType) * count, alignof(ItemType)));
+		}
+
+		void deallocate(ItemType*, size_t) noexcept {}
+
+		Arena* arena() const noexcept {
+			return this->arena_;
+		}
+
+		template<typename OtherType>
+		bool operator==(const ArenaAllocator<OtherType>& other) const noexcept {
+			return this->arena_ == other.arena();
+		}
+
+		template<typename OtherType>
+		bool operator!=(const ArenaAllocator<OtherType>& other) const noexcept {
+			return this->arena_ != other.arena();
+		}
+	};
+
+
+	/**
+	 * Checks if allocator releases all of its memory at once, so containers may skip returning their nodes one by one.
+	 */
+	template<typename AllocatorType, typename = void>
+	struct releases_in_bulk : std::false_type {};
+
+	template<typename AllocatorType>
+	struct releases_in_bulk<AllocatorType, std::void_t<typename AllocatorType::releases_in_bulk>> : AllocatorType::releases_in_bulk {};
+
+	/**
+	 * True when container using allocator doesn't have to walk its nodes during teardown - nodes need no destruction
+	 * and their memory is released all at once.
+	 */
+	template<typename AllocatorType, typename ItemType>
+	inline constexpr bool skips_teardown_v = releases_in_bulk<AllocatorType>::value && std::is_trivially_destructible_v<ItemType>;
+}
+
+#endif //ARENAALLOCATOR_H
@@ -1,32 +1,112 @@
 #ifndef ARRAYLIST_H
 #define ARRAYLIST_H
 
+#include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 
 namespace Containers {
 
 	/**
-	* Class representing sequential collection that utilizes internal array storage
+	* Class representing sequential collection that utilizes internal array storage.
+	* Array grows geometrically, so inserting at the back is amortised constant time. Items don't have to be copyable.
 	*
 	* \tparam ItemType : type of elements
 	* \tparam AllocatorType : allocator used for handling internal array
 	*/
 	template <typename ItemType, typename AllocatorType = std::allocator<ItemType>>
 	class ArrayList {
+		using MyType = ArrayList<ItemType, AllocatorType>;
+
+		// capacity of first allocated array
+		static constexpr size_t MINIMAL_CAPACITY = 8;
+
 		AllocatorType allocator_;
 
 		ItemType* items_ = nullptr;
 		size_t capacity_ = 0;
 		size_t size_ = 0;
 
+		/**
+		 * Destroys items in range <from, to) - this process goes in reverse
+		 */
+		void destroy_items_(ItemType* items, size_t from, size_t to) {
+			if constexpr (not std::is_trivially_destructible_v<ItemType>) {
+				while (to > from) {
+					--to;
+					std::allocator_traits<AllocatorType>::destroy(this->allocator_, &items[to]);
+				}
+			}
+		}
+
+		/**
+		 * Moves items into new array with given capacity. Items are copied instead when moving may throw and copying is possible,
+		 * so collection stays untouched if exception happens.
+		 *
+		 * \tparam WITH_NEW_ITEM : new item is constructed behind last item
+		 * \param capacity : capacity of new array, it isn't smaller than size of collection (plus new item)
+		 * \param arguments : arguments of constructor of new item, it is constructed before old items are moved, so it can refer to them
+		 */
+		template<bool WITH_NEW_ITEM, typename... ArgumentTypes>
+		void reallocate_(const size_t capacity, ArgumentTypes&&... arguments) {
+			ItemType* items = std::allocator_traits<AllocatorType>::allocate(this->allocator_, capacity);
+			size_t constructed = 0;
+
+			try {
+				if constexpr (WITH_NEW_ITEM) {
+					std::allocator_traits<AllocatorType>::construct(this->allocator_, &items[this->size_], std::forward<ArgumentTypes>(arguments)...);
+				}
+
+				for (; constructed < this->size_; ++constructed) {
+					std::allocator_traits<AllocatorType>::construct(this->allocator_, &items[constructed], std::move_if_noexcept(this->items_[constructed]));
+				}
+			}
+			catch (...) {
+				this->destroy_items_(items, 0, constructed);
+				if constexpr (WITH_NEW_ITEM) {
+					std::allocator_traits<AllocatorType>::destroy(this->allocator_, &items[this->size_]);
+				}
+				std::allocator_traits<AllocatorType>::deallocate(this->allocator_, items, capacity);
+				throw;
+			}
+
+			this->release_();
+
+			this->items_ = items;
+			this->capacity_ = capacity;
+		}
+
+		/**
+		 * Destroys items and returns array to allocator. Size is not changed.
+		 */
+		void release_() {
+			if (this->items_ == nullptr) {
+				return;
+			}
+
+			this->destroy_items_(this->items_, 0, this->size_);
+			std::allocator_traits<AllocatorType>::deallocate(this->allocator_, this->items_, this->capacity_);
+
+			this->items_ = nullptr;
+			this->capacity_ = 0;
+		}
+
+		/**
+		 * Capacity that array gets when it is full
+		 */
+		size_t grown_capacity_() const {
+			return (this->capacity_ == 0) ? MINIMAL_CAPACITY : this->capacity_ * 2;
+		}
+
 
 	public:
 		/**
-		* Creates an empty ArrayList with default allocator
+		* Creates an empty ArrayList with default allocator. Nothing is allocated until first item is inserted.
 		*/
-		explicit ArrayList() {}
+		ArrayList() = default;
 
 		/**
 		* Creates empty ArrayList using passed allocator
@@ -42,36 +122,164 @@ namespace Containers {
 		* \param defaultValue : value to which every position will be initialized
 		* \param allocator : allocator that will be used by collection
 		*/
-		ArrayList(size_t size, ItemType defaultValue, const AllocatorType& allocator = AllocatorType()) : allocator_(allocator) {
-			// allocation
-			this->capacity_ = size;
-			this->size_ = size;
-			this->items_ = std::allocator_traits<AllocatorType>::allocate(this->allocator_, this->capacity_);
+		ArrayList(size_t size, const ItemType& defaultValue, const AllocatorType& allocator = AllocatorType()) : allocator_(allocator) {
+			this->reserve(size);
+
+			for (size_t index = 0; index < size; ++index) {
+				this->push_back(defaultValue);
+			}
+		}
+
+		/**
+		 * Creates ArrayList with copies of items of other ArrayList. Copy uses same allocator as other ArrayList.
+		 */
+		ArrayList(const MyType& other) : allocator_(other.allocator_) {
+			this->reserve(other.size_);
+
+			for (size_t index = 0; index < other.size_; ++index) {
+				this->push_back(other.items_[index]);
+			}
+		}
+
+		/**
+		 * Takes over array of other ArrayList. Other ArrayList is left empty.
+		 */
+		ArrayList(MyType&& other) noexcept : allocator_(other.allocator_), items_(other.items_), capacity_(other.capacity_), size_(other.size_) {
+			other.items_ = nullptr;
+			other.capacity_ = 0;
+			other.size_ = 0;
+		}
+
+		/**
+		 * Replaces items of ArrayList with copies of items of other ArrayList. Array is reused when it is large enough.
+		 */
+		MyType& operator=(const MyType& other) {
+			if (this == &other) {
+				return *this;
+			}
+
+			this->clear();
+			this->reserve(other.size_);
+
+			for (size_t index = 0; index < other.size_; ++index) {
+				this->push_back(other.items_[index]);
+			}
+
+			return *this;
+		}
 
-			// construction
-			for (size_t index = 0; index < this->capacity_; ++index) {
-				std::allocator_traits<AllocatorType>::construct(this->allocator_, &this->items_[index], defaultValue);
+		/**
+		 * Replaces items of ArrayList with array of other ArrayList. Other ArrayList is left empty.
+		 */
+		MyType& operator=(MyType&& other) noexcept {
+			if (this == &other) {
+				return *this;
 			}
+
+			this->release_();
+
+			this->items_ = other.items_;
+			this->capacity_ = other.capacity_;
+			this->size_ = other.size_;
+			other.items_ = nullptr;
+			other.capacity_ = 0;
+			other.size_ = 0;
+
+			return *this;
 		}
 
 		/**
 		* Destroys ArrayList
 		*/
 		~ArrayList() {
-			// no items? Do nothing
-			if(this->size_ == 0) {
+			this->release_();
+			this->size_ = 0;
+		}
+
+		/**
+		 * Inserts copy of item to the back of ArrayList
+		 *
+		 * \param value : item to be inserted
+		 * \return item that is now stored inside of ArrayList
+		 */
+		ItemType& push_back(const ItemType& value) {
+			return this->emplace_back(value);
+		}
+
+		/**
+		 * Moves item to the back of ArrayList
+		 *
+		 * \param value : item to be inserted
+		 * \return item that is now stored inside of ArrayList
+		 */
+		ItemType& push_back(ItemType&& value) {
+			return this->emplace_back(std::move(value));
+		}
+
+		/**
+		 * Constructs item directly at the back of ArrayList. When array is full, it is replaced by one with double capacity.
+		 *
+		 * \param arguments : arguments passed to constructor of item, they may refer to items of this ArrayList
+		 * \return item that is now stored inside of ArrayList
+		 */
+		template<typename... ArgumentTypes>
+		ItemType& emplace_back(ArgumentTypes&&... arguments) {
+			if (this->size_ == this->capacity_) {
+				this->reallocate_<true>(this->grown_capacity_(), std::forward<ArgumentTypes>(arguments)...);
+			}
+			else {
+				std::allocator_traits<AllocatorType>::construct(this->allocator_, &this->items_[this->size_], std::forward<ArgumentTypes>(arguments)...);
+			}
+
+			return this->items_[this->size_++];
+		}
+
+		/**
+		 * Removes last item
+		 *
+		 * \throw std::out_of_range : ArrayList is empty
+		 */
+		void pop_back() {
+			if (this->size_ == 0) {
+				throw std::out_of_range("Cannot pop from empty list.");
+			}
+
+			--this->size_;
+			std::allocator_traits<AllocatorType>::destroy(this->allocator_, &this->items_[this->size_]);
+		}
+
+		/**
+		 * Makes sure that ArrayList can hold at least given number of items without allocating
+		 *
+		 * \param capacity : expected number of items
+		 */
+		void reserve(const size_t capacity) {
+			if (capacity > this->capacity_) {
+				this->reallocate_<false>(capacity);
+			}
+		}
+
+		/**
+		 * Returns memory that is not used by items to allocator
+		 */
+		void shrink_to_fit() {
+			if (this->size_ == this->capacity_) {
 				return;
 			}
 
-			// destroy stored objects - this process goes in reverse
-			for (size_t index = this->size_ - 1; index > 0; --index) {
-				std::allocator_traits<AllocatorType>::destroy(this->allocator_, &this->items_[index]);
+			if (this->size_ == 0) {
+				this->release_();
+				return;
 			}
 
-			// deallocate array itself
-			std::allocator_traits<AllocatorType>::deallocate(this->allocator_, this->items_, this->capacity_);
-			this->items_ = nullptr;
-			this->capacity_ = 0;
+			this->reallocate_<false>(this->size_);
+		}
+
+		/**
+		 * Destroys every item. Array is kept, so ArrayList can be filled again without allocating.
+		 */
+		void clear() {
+			this->destroy_items_(this->items_, 0, this->size_);
 			this->size_ = 0;
 		}
 
@@ -93,6 +301,55 @@ namespace Containers {
 			return this->items_[index];
 		}
 
+		/**
+		* Returns reference to item at specified index. Performs bound checking.
+		*
+		* \param index : index of requested item.
+		* \throw std::out_of_range : index is not smaller than size
+		*/
+		ItemType& at(size_t index) {
+			if (index >= this->size_) {
+				throw std::out_of_range("Index out of range.");
+			}
+
+			return this->items_[index];
+		}
+
+		/**
+		* Returns constant reference to item at specified index. Performs bound checking.
+		*
+		* \param index : index of requested item.
+		* \throw std::out_of_range : index is not smaller than size
+		*/
+		const ItemType& at(size_t index) const {
+			if (index >= this->size_) {
+				throw std::out_of_range("Index out of range.");
+			}
+
+			return this->items_[index];
+		}
+
+		/**
+		 * Returns first item. Doesn't check if ArrayList is empty.
+		 */
+		ItemType& front() {
+			return this->items_[0];
+		}
+
+		/**
+		 * Returns last item. Doesn't check if ArrayList is empty.
+		 */
+		ItemType& back() {
+			return this->items_[this->size_ - 1];
+		}
+
+		/**
+		 * Returns pointer to internal array
+		 */
+		ItemType* data() {
+			return this->items_;
+		}
+
 		/**
 		 * Returns size/number of items in this ArrayList
 		 */
@@ -100,41 +357,69 @@ namespace Containers {
 			return this->size_;
 		};
 
+		/**
+		 * Returns number of items ArrayList can hold before it has to allocate
+		 */
+		size_t capacity() const {
+			return this->capacity_;
+		}
+
+		/**
+		 * Checks if ArrayList is empty
+		 */
+		bool empty() const {
+			return this->size_ == 0;
+		}
+
 
 		/**
-		 * Represents basic forward input/output iterator
+		 * Represents random access iterator over items - it is thin wrapper of pointer into internal array
 		 *
-		 * TODO: Maybe convert this to bidirectional one
+		 * \tparam AccessedType : ItemType or const ItemType
 		 */
-		class Iterator {
-			ItemType* position_;
+		template<typename AccessedType>
+		class IteratorBase {
+			AccessedType* position_ = nullptr;
 
 		public:
-			using iterator_category = std::bidirectional_iterator_tag;
+			using iterator_category = std::random_access_iterator_tag;
+			using iterator_concept = std::random_access_iterator_tag;
 
-			using value_type = ItemType;
-			using pointer = ItemType*;
-			using reference = ItemType&;
+			using value_type = std::remove_const_t<AccessedType>;
+			using pointer = AccessedType*;
+			using reference = AccessedType&;
 			using difference_type = std::ptrdiff_t;
 
 
-			Iterator(ItemType* position) : position_(position) {}
+			IteratorBase() = default;
+
+			explicit IteratorBase(AccessedType* position) : position_(position) {}
+
+			/**
+			 * Iterator can be converted to constant iterator
+			 */
+			template<typename OtherType, typename = std::enable_if_t<std::is_same_v<const OtherType, AccessedType>>>
+			IteratorBase(const IteratorBase<OtherType>& other) : position_(other.operator->()) {}
 
 			reference operator*() const {
 				return *this->position_;
 			}
 
-			pointer operator->() {
+			pointer operator->() const {
 				return this->position_;
 			}
 
-			Iterator& operator++() {
+			reference operator[](difference_type distance) const {
+				return this->position_[distance];
+			}
+
+			IteratorBase& operator++() {
 				++this->position_;
 
 				return *this;
 			}
 
-			Iterator operator++(int) {
+			IteratorBase operator++(int) {
 				auto old = *this;
 
 				++(*this);
@@ -142,13 +427,13 @@ namespace Containers {
 				return old;
 			}
 
-			Iterator& operator--() {
+			IteratorBase& operator--() {
 				--this->position_;
 
 				return *this;
 			}
 
-			Iterator operator--(int) {
+			IteratorBase operator--(int) {
 				auto old = *this;
 
 				--(*this);
@@ -156,23 +441,67 @@ namespace Containers {
 				return old;
 			}
 
-			Iterator operator+(difference_type distance) const {
-				return Iterator(position_ + distance);
+			IteratorBase& operator+=(difference_type distance) {
+				this->position_ += distance;
+
+				return *this;
+			}
+
+			IteratorBase& operator-=(difference_type distance) {
+				this->position_ -= distance;
+
+				return *this;
+			}
+
+			IteratorBase operator+(difference_type distance) const {
+				return IteratorBase(this->position_ + distance);
+			}
+
+			friend IteratorBase operator+(difference_type distance, const IteratorBase& iterator) {
+				return iterator + distance;
 			}
 
-			Iterator operator-(difference_type distance) const {
-				return Iterator(position_ - distance);
+			IteratorBase operator-(difference_type distance) const {
+				return IteratorBase(this->position_ - distance);
 			}
 
-			bool operator==(const Iterator& other) {
+			difference_type operator-(const IteratorBase& other) const {
+				return this->position_ - other.position_;
+			}
+
+			bool operator==(const IteratorBase& other) const {
 				return this->position_ == other.position_;
 			}
 
-			bool operator!=(const Iterator& other) {
+			bool operator!=(const IteratorBase& other) const {
 				return this->position_ != other.position_;
 			}
+
+			bool operator<(const IteratorBase& other) const {
+				return this->position_ < other.position_;
+			}
+
+			bool operator<=(const IteratorBase& other) const {
+				return this->position_ <= other.position_;
+			}
+
+			bool operator>(const IteratorBase& other) const {
+				return this->position_ > other.position_;
+			}
+
+			bool operator>=(const IteratorBase& other) const {
+				return this->position_ >= other.position_;
+			}
 		};
 
+		using Iterator = IteratorBase<ItemType>;
+		using ConstIterator = IteratorBase<const ItemType>;
+
+#if defined(__cpp_lib_concepts)
+		static_assert(std::random_access_iterator<Iterator>);
+		static_assert(std::random_access_iterator<ConstIterator>);
+#endif
+
 
 		/**
 		 * Creates iterator pointing at the beginning of ArrayList
@@ -187,6 +516,45 @@ namespace Containers {
 		Iterator end() {
 			return Iterator(this->items_ + this->size_);
 		}
+
+		ConstIterator begin() const {
+			return ConstIterator(this->items_);
+		}
+
+		ConstIterator end() const {
+			return ConstIterator(this->items_ + this->size_);
+		}
+
+
+		/**
+		 * Output iterator which inserts every assigned item at the back of ArrayList
+		 */
+		class PushBackIterator {
+			MyType* my_list_;
+
+		public:
+			explicit PushBackIterator(MyType* my_list) : my_list_(my_list) {};
+
+
+			PushBackIterator operator*() {
+				return *this;
+			};
+
+			PushBackIterator& operator++() {
+				return *this;
+			}
+
+			PushBackIterator& operator=(const ItemType& item) {
+				this->my_list_->push_back(item);
+
+				return *this;
+			}
+
+		};
+
+		PushBackIterator push_backer() {
+			return PushBackIterator(this);
+		}
 	};
 };
 
@@ -0,0 +1,576 @@
+#ifndef FLATTABLE_H
+#define FLATTABLE_H
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "ArenaAllocator.h"
+#include "Hashing.h"
+
+namespace Containers {
+	/**
+	 * Represents hash table stored in one flat array of slots (open addressing) - it has same interface as LinkedTable.
+	 * Collisions are resolved by linear probing with Robin Hood ordering: items of every run of occupied slots are
+	 * sorted by their home slot, so item which is further from its home never stands behind item which is closer.
+	 * Probe sequences stay short and lookup of missing key stops as soon as it meets item closer to its home than key would be.
+	 * Every slot also keeps few bits of hash of its key, so keys are compared only when these bits match.
+	 *
+	 * NOTE: items are moved inside of table when it grows, when they are shifted by insertion or by erasing,
+	 *       so pointers returned by table are valid only until next insertion or erasing
+	 *
+	 * \tparam KeyType : type of key object that identifies pair
+	 * \tparam ValueType : type of value stored in pair
+	 * \tparam AllocatorType : type of allocator used by table internally
+	 * \tparam HashType : hash of keys - if it and KeyEqualType are transparent, table can be searched by other types than KeyType
+	 * \tparam KeyEqualType : comparator of keys
+	 */
+	template <
+		typename KeyType,
+		typename ValueType,
+		typename AllocatorType = std::allocator<std::pair<const KeyType, ValueType>>,
+		typename HashType = DefaultHash<KeyType>,
+		typename KeyEqualType = DefaultKeyEqual<KeyType>
+	>
+	class FlatTable {
+		using MyType = FlatTable<KeyType, ValueType, AllocatorType, HashType, KeyEqualType>;
+		using ItemType = std::pair<const KeyType, ValueType>;
+
+		/**
+		 * Metadata of slot - it is stored apart from items, so probing walks over small contiguous array
+		 */
+		struct SlotInfo {
+			// distance of item from its home slot, increased by one - zero marks empty slot
+			uint16_t distance = 0;
+
+			// part of hash of item's key
+			uint16_t fingerprint = 0;
+		};
+
+		using ItemAllocatorType = typename std::allocator_traits<AllocatorType>::template rebind_alloc<ItemType>;
+		using InfoAllocatorType = typename std::allocator_traits<AllocatorType>::template rebind_alloc<SlotInfo>;
+
+		// allocators
+		ItemAllocatorType itemAllocator_;
+		InfoAllocatorType infoAllocator_;
+
+		// tools for key indexing and comparing
+		HashType keyHash_;
+		KeyEqualType keyEqual_;
+
+		// slots and their metadata - capacity is always power of two
+		ItemType* slots_ = nullptr;
+		SlotInfo* infos_ = nullptr;
+		size_t capacity_ = 0;
+		size_t itemCount_ = 0;
+
+		// number of bits of hash used as index of home slot
+		unsigned indexBits_ = 0;
+
+		/**
+		 * Returns hash of key multiplied by golden ratio (fibonacci hashing),
+		 * so keys with weak hashes (e.g. aligned pointers) are spread over all slots.
+		 */
+		template<typename LookupKeyType>
+		uint64_t mixed_hash_(const LookupKeyType& key) const {
+			return static_cast<uint64_t>(this->keyHash_(key)) * 0x9E3779B97F4A7C15ull;
+		}
+
+		/**
+		 * Returns home slot of key - highest bits of mixed hash are the best ones
+		 */
+		size_t home_index_(const uint64_t mixed_hash) const {
+			return static_cast<size_t>(mixed_hash >> (64 - this->indexBits_));
+		}
+
+		static uint16_t fingerprint_(const uint64_t mixed_hash) {
+			return static_cast<uint16_t>(mixed_hash >> 16);
+		}
+
+		size_t next_index_(const size_t index) const {
+			return (index + 1) & (this->capacity_ - 1);
+		}
+
+		size_t previous_index_(const size_t index) const {
+			return (index - 1) & (this->capacity_ - 1);
+		}
+
+		/**
+		 * Checks if table with specified capacity can hold item count without growing
+		 */
+		static bool fits_(const size_t itemCount, const size_t capacity) {
+			// we will resize ONLY if item count would exceed 7/8 of capacity
+			return itemCount * 8 <= capacity * 7;
+		}
+
+		/**
+		 * Searches for slot with same key as passed one. DOESN'T CHECK IF SLOTS ARE EMPTY
+		 *
+		 * \return index of slot, capacity if table doesn't contain key
+		 */
+		template<typename LookupKeyType>
+		size_t find_index_(const LookupKeyType& key, const uint64_t mixed_hash) const {
+			auto fingerprint = fingerprint_(mixed_hash);
+
+			size_t index = this->home_index_(mixed_hash);
+			uint16_t distance = 1;
+
+			// items further than key would be can still be followed by key, closer items cannot
+			while (this->infos_[index].distance >= distance) {
+				auto& info = this->infos_[index];
+				if (info.distance == distance && info.fingerprint == fingerprint && this->keyEqual_(key, this->slots_[index].first)) {
+					return index;
+				}
+
+				index = this->next_index_(index);
+				++distance;
+			}
+
+			return this->capacity_;
+		}
+
+		/**
+		 * Prepares slot for new item. Items which are closer to their home than new item would be are shifted
+		 * by one slot towards the nearest free slot. KEY MUST NOT BE IN TABLE AND TABLE MUST HAVE FREE SLOT
+		 *
+		 * \param mixed_hash : mixed hash of key of new item
+		 * \return index of slot - it is marked as occupied, but item is not constructed in it yet
+		 * \throw std::overflow_error : item is too far from its home slot (hash of keys is really bad)
+		 */
+		size_t make_room_(const uint64_t mixed_hash) {
+			size_t index = this->home_index_(mixed_hash);
+			SlotInfo new_info = {1, fingerprint_(mixed_hash)};
+
+			// new item goes before first item closer to its home
+			while (this->infos_[index].distance >= new_info.distance) {
+				if (new_info.distance == UINT16_MAX) {
+					throw std::overflow_error("Probe sequence of table is too long.");
+				}
+
+				index = this->next_index_(index);
+				++new_info.distance;
+			}
+
+			// find end of run which has to be shifted
+			size_t free_index = index;
+			while (this->infos_[free_index].distance != 0) {
+				if (this->infos_[free_index].distance == UINT16_MAX) {
+					throw std::overflow_error("Probe sequence of table is too long.");
+				}
+
+				free_index = this->next_index_(free_index);
+			}
+
+			// shift run by one slot, starting from its end
+			while (free_index != index) {
+				auto previous = this->previous_index_(free_index);
+
+				std::allocator_traits<ItemAllocatorType>::construct(this->itemAllocator_, &this->slots_[free_index], std::move(this->slots_[previous]));
+				std::allocator_traits<ItemAllocatorType>::destroy(this->itemAllocator_, &this->slots_[previous]);
+
+				this->infos_[free_index] = this->infos_[previous];
+				++this->infos_[free_index].distance;
+
+				free_index = previous;
+			}
+
+			this->infos_[index] = new_info;
+			return index;
+		}
+
+		/**
+		 * Moves every item into new array of slots
+		 *
+		 * \param capacity : new number of slots - power of two
+		 */
+		void rehash_(const size_t capacity) {
+			// store old internals
+			ItemType* oldSlots = this->slots_;
+			SlotInfo* oldInfos = this->infos_;
+			size_t oldCapacity = this->capacity_;
+
+			// create new internals
+			this->capacity_ = capacity;
+			this->indexBits_ = 0;
+			while ((static_cast<size_t>(1) << this->indexBits_) < capacity) {
+				++this->indexBits_;
+			}
+			this->slots_ = std::allocator_traits<ItemAllocatorType>::allocate(this->itemAllocator_, this->capacity_);
+			this->infos_ = std::allocator_traits<InfoAllocatorType>::allocate(this->infoAllocator_, this->capacity_);
+
+			for (size_t index = 0; index < this->capacity_; ++index) {
+				this->infos_[index] = SlotInfo();
+			}
+
+			// move every item into new slots
+			for (size_t index = 0; index < oldCapacity; ++index) {
+				if (oldInfos[index].distance != 0) {
+					auto new_index = this->make_room_(this->mixed_hash_(oldSlots[index].first));
+
+					std::allocator_traits<ItemAllocatorType>::construct(this->itemAllocator_, &this->slots_[new_index], std::move(oldSlots[index]));
+					std::allocator_traits<ItemAllocatorType>::destroy(this->itemAllocator_, &oldSlots[index]);
+				}
+			}
+
+			if (oldCapacity != 0) {
+				std::allocator_traits<ItemAllocatorType>::deallocate(this->itemAllocator_, oldSlots, oldCapacity);
+				std::allocator_traits<InfoAllocatorType>::deallocate(this->infoAllocator_, oldInfos, oldCapacity);
+			}
+		}
+
+		/**
+		 * Checks if table is too full and expands it if needed
+		 */
+		void resolve_fullness_() {
+			if (fits_(this->itemCount_ + 1, this->capacity_)) {
+				return;
+			}
+
+			this->rehash_((this->capacity_ == 0) ? 8 : (this->capacity_ * 2));
+		}
+
+		/**
+		 * Creates description of key for error messages. Only keys from which string can be constructed are described by their content.
+		 */
+		template<typename LookupKeyType>
+		static std::string describe_key_(const LookupKeyType& key) {
+			if constexpr (std::is_constructible_v<std::string, const LookupKeyType&>) {
+				return "Key '" + std::string(key) + "'";
+			}
+			else {
+				return "Key";
+			}
+		}
+
+	public:
+		FlatTable() : itemAllocator_(), infoAllocator_(this->itemAllocator_) {};
+
+		FlatTable(const AllocatorType& allocator) : itemAllocator_(allocator), infoAllocator_(this->itemAllocator_) {};
+
+		/**
+		 * Creates table with copies of every pair of other table. Copy uses same allocator as other table.
+		 */
+		FlatTable(const MyType& other)
+			: itemAllocator_(other.itemAllocator_), infoAllocator_(other.infoAllocator_), keyHash_(other.keyHash_), keyEqual_(other.keyEqual_) {
+			if (other.itemCount_ == 0) {
+				return;
+			}
+
+			// same capacity and same hashes - every item ends in the same slot as in other table
+			this->rehash_(other.capacity_);
+
+			for (size_t index = 0; index < other.capacity_; ++index) {
+				if (other.infos_[index].distance != 0) {
+					std::allocator_traits<ItemAllocatorType>::construct(this->itemAllocator_, &this->slots_[index], other.slots_[index]);
+					this->infos_[index] = other.infos_[index];
+				}
+			}
+
+			this->itemCount_ = other.itemCount_;
+		};
+
+		MyType& operator=(const MyType& other) = delete;
+
+		~FlatTable() {
+			if (this->slots_ == nullptr) {
+				return;
+			}
+
+			// items of bulk releasing allocator don't have to be destroyed one by one
+			if constexpr (not skips_teardown_v<ItemAllocatorType, ItemType>) {
+				for (size_t index = 0; index < this->capacity_; ++index) {
+					if (this->infos_[index].distance != 0) {
+						std::allocator_traits<ItemAllocatorType>::destroy(this->itemAllocator_, &this->slots_[index]);
+					}
+				}
+			}
+			std::allocator_traits<ItemAllocatorType>::deallocate(this->itemAllocator_, this->slots_, this->capacity_);
+			std::allocator_traits<InfoAllocatorType>::deallocate(this->infoAllocator_, this->infos_, this->capacity_);
+			this->capacity_ = 0;
+			this->itemCount_ = 0;
+		};
+
+		/**
+		 * Inserts value constructed from arguments, but only if key is not in table yet.
+		 * Value is constructed directly in its slot.
+		 *
+		 * \param key : key of inserted value
+		 * \param arguments : arguments passed to constructor of value - they are not used when key already exists
+		 * \return <value, true> when value was inserted, <existing value, false> when key already exists
+		 */
+		template<typename... ArgumentTypes>
+		std::pair<ValueType*, bool> try_emplace(const KeyType& key, ArgumentTypes&&... arguments) {
+			auto mixed_hash = this->mixed_hash_(key);
+
+			if (this->slots_ != nullptr) {
+				auto index = this->find_index_(key, mixed_hash);
+				if (index != this->capacity_) {
+					return std::make_pair(&this->slots_[index].second, false);
+				}
+			}
+
+			this->resolve_fullness_();
+
+			auto index = this->make_room_(mixed_hash);
+			std::allocator_traits<ItemAllocatorType>::construct(
+				this->itemAllocator_, &this->slots_[index],
+				std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<ArgumentTypes>(arguments)...)
+			);
+
+			++this->itemCount_;
+
+			return std::make_pair(&this->slots_[index].second, true);
+		};
+
+		/**
+		 * Returns value stored under key. If there is none, it is constructed from arguments first.
+		 *
+		 * \param key : key of requested value
+		 * \param arguments : arguments passed to constructor of value - they are not used when key already exists
+		 */
+		template<typename... ArgumentTypes>
+		ValueType& find_or_insert(const KeyType& key, ArgumentTypes&&... arguments) {
+			return *this->try_emplace(key, std::forward<ArgumentTypes>(arguments)...).first;
+		};
+
+		ValueType& insert(const KeyType& key, const ValueType& value) {
+			auto result = this->try_emplace(key, value);
+			if (not result.second) {
+				throw std::out_of_range(describe_key_(key) + " already exists.");
+			}
+
+			return *result.first;
+		};
+
+		ValueType& insert(const KeyType& key, ValueType&& value) {
+			auto result = this->try_emplace(key, std::move(value));
+			if (not result.second) {
+				throw std::out_of_range(describe_key_(key) + " already exists.");
+			}
+
+			return *result.first;
+		};
+
+		ValueType* try_insert(const KeyType& key, const ValueType& value) {
+			auto result = this->try_emplace(key, value);
+			return result.second ? result.first : nullptr;
+		};
+
+		ValueType* try_insert(const KeyType& key, ValueType&& value) {
+			auto result = this->try_emplace(key, std::move(value));
+			return result.second ? result.first : nullptr;
+		};
+
+		/**
+		 * Removes pair with specified key. Items behind it are shifted back by one slot (backward shift deletion),
+		 * so table needs no tombstones.
+		 *
+		 * \param key : key of removed pair
+		 * \return true if pair was removed, false if table doesn't contain key
+		 */
+		template<typename LookupKeyType, typename = std::enable_if_t<accepts_lookup_key_v<KeyType, LookupKeyType, HashType, KeyEqualType>>>
+		bool erase(const LookupKeyType& key) {
+			if (this->slots_ == nullptr) {
+				return false;
+			}
+
+			auto index = this->find_index_(key, this->mixed_hash_(key));
+			if (index == this->capacity_) {
+				return false;
+			}
+
+			std::allocator_traits<ItemAllocatorType>::destroy(this->itemAllocator_, &this->slots_[index]);
+
+			// items which are not in their home slot move one slot closer to it
+			auto next = this->next_index_(index);
+			while (this->infos_[next].distance > 1) {
+				std::allocator_traits<ItemAllocatorType>::construct(this->itemAllocator_, &this->slots_[index], std::move(this->slots_[next]));
+				std::allocator_traits<ItemAllocatorType>::destroy(this->itemAllocator_, &this->slots_[next]);
+
+				this->infos_[index] = this->infos_[next];
+				--this->infos_[index].distance;
+
+				index = next;
+				next = this->next_index_(next);
+			}
+
+			this->infos_[index] = SlotInfo();
+			--this->itemCount_;
+
+			return true;
+		};
+
+		bool erase(const KeyType& key) {
+			return this->erase<KeyType>(key);
+		};
+
+		/**
+		 * Prepares table for specified number of items, so it doesn't have to grow while they are inserted
+		 */
+		void reserve(const size_t itemCount) {
+			size_t capacity = (this->capacity_ == 0) ? 8 : this->capacity_;
+			while (not fits_(itemCount, capacity)) {
+				capacity *= 2;
+			}
+
+			if (capacity > this->capacity_) {
+				this->rehash_(capacity);
+			}
+		};
+
+		/**
+		 * Searches for value stored under key. Doesn't throw when key is missing.
+		 *
+		 * \param key : key of requested value
+		 * \return pointer to value, nullptr if table doesn't contain key
+		 */
+		ValueType* find(const KeyType& key) {
+			return this->find<KeyType>(key);
+		};
+
+		const ValueType* find(const KeyType& key) const {
+			return this->find<KeyType>(key);
+		};
+
+		/**
+		 * Searches for value stored under key of other type (e.g. std::string in table with std::string_view keys).
+		 * Key is not converted, so no temporary is created. Available only with transparent hash and comparator.
+		 *
+		 * \param key : key of requested value
+		 * \return pointer to value, nullptr if table doesn't contain key
+		 */
+		template<typename LookupKeyType, typename = std::enable_if_t<accepts_lookup_key_v<KeyType, LookupKeyType, HashType, KeyEqualType>>>
+		ValueType* find(const LookupKeyType& key) {
+			if (this->slots_ == nullptr) {
+				return nullptr;
+			}
+
+			auto index = this->find_index_(key, this->mixed_hash_(key));
+			return (index == this->capacity_) ? nullptr : &this->slots_[index].second;
+		};
+
+		template<typename LookupKeyType, typename = std::enable_if_t<accepts_lookup_key_v<KeyType, LookupKeyType, HashType, KeyEqualType>>>
+		const ValueType* find(const LookupKeyType& key) const {
+			if (this->slots_ == nullptr) {
+				return nullptr;
+			}
+
+			auto index = this->find_index_(key, this->mixed_hash_(key));
+			return (index == this->capacity_) ? nullptr : &this->slots_[index].second;
+		};
+
+		ValueType& at(const KeyType& key) {
+			return this->at<KeyType>(key);
+		};
+
+		const ValueType& at(const KeyType& key) const {
+			return this->at<KeyType>(key);
+		};
+
+		template<typename LookupKeyType, typename = std::enable_if_t<accepts_lookup_key_v<KeyType, LookupKeyType, HashType, KeyEqualType>>>
+		ValueType& at(const LookupKeyType& key) {
+			auto value = this->find(key);
+			if (value == nullptr) {
+				throw std::out_of_range(describe_key_(key) + " doesn't exists.");
+			}
+
+			return *value;
+		};
+
+		template<typename LookupKeyType, typename = std::enable_if_t<accepts_lookup_key_v<KeyType, LookupKeyType, HashType, KeyEqualType>>>
+		const ValueType& at(const LookupKeyType& key) const {
+			auto value = this->find(key);
+			if (value == nullptr) {
+				throw std::out_of_range(describe_key_(key) + " doesn't exists.");
+			}
+
+			return *value;
+		};
+
+		/**
+		 * Returns number of items in table
+		 */
+		size_t size() const {
+			return this->itemCount_;
+		}
+
+		bool empty() const {
+			return this->itemCount_ == 0;
+		}
+
+
+		/**
+		 * Represents forward iterator over pairs of table. Pairs are visited in order of slots.
+		 */
+		class Iterator {
+			ItemType* slots_;
+			SlotInfo* infos_;
+			size_t capacity_;
+			size_t index_;
+
+			// moves to next occupied slot (starting with current one)
+			void skip_empty_slots_() {
+				while (this->index_ < this->capacity_ && this->infos_[this->index_].distance == 0) {
+					++this->index_;
+				}
+			}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+
+			using value_type = ItemType;
+			using pointer = ItemType*;
+			using reference = ItemType&;
+			using difference_type = std::ptrdiff_t;
+
+			Iterator(ItemType* slots, SlotInfo* infos, const size_t capacity, const size_t index)
+				: slots_(slots), infos_(infos), capacity_(capacity), index_(index) {
+				this->skip_empty_slots_();
+			}
+
+			reference operator*() const {
+				return this->slots_[this->index_];
+			}
+
+			pointer operator->() const {
+				return &this->slots_[this->index_];
+			}
+
+			Iterator& operator++() {
+				++this->index_;
+				this->skip_empty_slots_();
+
+				return *this;
+			}
+
+			Iterator operator++(int) {
+				Iterator old = *this;
+				++(*this);
+				return old;
+			}
+
+			bool operator==(const Iterator& other) const {
+				return this->index_ == other.index_;
+			}
+
+			bool operator!=(const Iterator& other) const {
+				return this->index_ != other.index_;
+			}
+		};
+
+		Iterator begin() {
+			return Iterator(this->slots_, this->infos_, this->capacity_, 0);
+		}
+
+		Iterator end() {
+			return Iterator(this->slots_, this->infos_, this->capacity_, this->capacity_);
+		}
+	};
+}
+
+#endif //FLATTABLE_H
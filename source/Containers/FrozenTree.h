@@ -0,0 +1,238 @@
+#ifndef FROZENTREE_H
+#define FROZENTREE_H
+
+#include <cstdint>
+#include <memory>
+
+#include "ArrayList.h"
+
+
+namespace Containers {
+
+	/**
+	 * Read-only copy of tree stored in one array in pre-order (compressed layout of tree that won't change anymore).
+	 * Every node knows index of its parent, end of its subtree and its depth, so:
+	 * - whole tree is traversed by scanning array from the beginning
+	 * - subtree of node at index i is range <i, subtree end)
+	 * - descendants are always behind their ancestors, so scanning array backwards visits children before parents
+	 *
+	 * \tparam ItemType : type of items copied from nodes
+	 * \tparam AllocatorType : allocator used for handling internal array
+	 */
+	template <typename ItemType, typename AllocatorType = std::allocator<ItemType>>
+	class FrozenTree {
+	public:
+		// parent index of root
+		static constexpr size_t NO_PARENT = SIZE_MAX;
+
+		/**
+		 * One node of tree - its position in array is its index
+		 */
+		struct Node {
+			ItemType item;
+
+			size_t parent;
+
+			// index behind last node of subtree
+			size_t subtree_end;
+
+			// root has depth 0
+			size_t depth;
+		};
+
+	private:
+		using NodeAllocatorType = typename std::allocator_traits<AllocatorType>::template rebind_alloc<Node>;
+
+		ArrayList<Node, NodeAllocatorType> nodes_;
+
+		/**
+		 * Returns node which follows node in pre-order of subtree of root (nullptr when subtree is finished).
+		 * Only links of nodes are used, so walk doesn't need any other memory.
+		 */
+		template<typename TreeNodeType>
+		static TreeNodeType* next_in_preorder_(TreeNodeType* node, const TreeNodeType* root) {
+			if (node->get_children() != nullptr) {
+				return node->get_children();
+			}
+
+			while (node != root && node->get_sibling() == nullptr) {
+				node = node->get_parent();
+			}
+
+			return (node == root) ? nullptr : node->get_sibling();
+		}
+
+	public:
+		/**
+		 * Creates empty tree
+		 *
+		 * \param allocator : allocator that will be used by tree
+		 */
+		explicit FrozenTree(const AllocatorType& allocator = AllocatorType()) : nodes_(NodeAllocatorType(allocator)) {}
+
+		/**
+		 * Copies subtree of root node into array. Siblings of root are not copied.
+		 *
+		 * \tparam TreeNodeType : node with get_item(), get_parent(), get_sibling() and get_children() (like TreeNode)
+		 * \param root : root of copied subtree
+		 * \param allocator : allocator that will be used by tree
+		 */
+		template<typename TreeNodeType>
+		explicit FrozenTree(TreeNodeType* root, const AllocatorType& allocator = AllocatorType()) : FrozenTree(allocator) {
+			// count nodes first, so array is allocated only once
+			size_t count = 0;
+			for (auto node = root; node != nullptr; node = next_in_preorder_(node, root)) {
+				++count;
+			}
+			this->nodes_.reserve(count);
+
+			// indexes of nodes whose subtree is not finished yet - last one is parent of next node
+			ArrayList<size_t> open_nodes;
+
+			TreeNodeType* node = root;
+			while (node != nullptr) {
+				size_t index = this->nodes_.size();
+				size_t parent = open_nodes.empty() ? NO_PARENT : open_nodes.back();
+
+				this->nodes_.push_back({node->get_item(), parent, index + 1, open_nodes.size()});
+
+				// node has children? They follow it directly
+				if (node->get_children() != nullptr) {
+					open_nodes.push_back(index);
+					node = node->get_children();
+					continue;
+				}
+
+				// leaf - go up until there is sibling, every node we leave has its subtree finished
+				while (node != root && node->get_sibling() == nullptr) {
+					node = node->get_parent();
+
+					this->nodes_[open_nodes.back()].subtree_end = this->nodes_.size();
+					open_nodes.pop_back();
+				}
+
+				node = (node == root) ? nullptr : node->get_sibling();
+			}
+		}
+
+		/**
+		 * Returns number of nodes
+		 */
+		size_t size() const {
+			return this->nodes_.size();
+		}
+
+		/**
+		 * Checks if tree has no nodes
+		 */
+		bool empty() const {
+			return this->nodes_.empty();
+		}
+
+		/**
+		 * Returns node at index. Doesn't perform bound checking.
+		 */
+		const Node& operator[](const size_t index) const {
+			return this->nodes_[index];
+		}
+
+		/**
+		 * Returns item of node at index. Doesn't perform bound checking.
+		 */
+		ItemType& get_item(const size_t index) {
+			return this->nodes_[index].item;
+		}
+
+		/**
+		 * Returns index of parent of node, NO_PARENT for root
+		 */
+		size_t get_parent(const size_t index) const {
+			return this->nodes_[index].parent;
+		}
+
+		/**
+		 * Returns index behind last node of subtree of node
+		 */
+		size_t get_subtree_end(const size_t index) const {
+			return this->nodes_[index].subtree_end;
+		}
+
+		/**
+		 * Returns number of nodes in subtree of node (including node itself)
+		 */
+		size_t get_subtree_size(const size_t index) const {
+			return this->nodes_[index].subtree_end - index;
+		}
+
+		/**
+		 * Returns distance of node from root
+		 */
+		size_t get_depth(const size_t index) const {
+			return this->nodes_[index].depth;
+		}
+
+		/**
+		 * Returns index of first child of node, or subtree end of node if it has no children
+		 */
+		size_t get_first_child(const size_t index) const {
+			return index + 1;
+		}
+
+		/**
+		 * Returns index of next sibling of node - it is directly behind subtree of node.
+		 * Returns subtree end of parent if node is last child (NO_PARENT for root).
+		 */
+		size_t get_next_sibling(const size_t index) const {
+			return (this->nodes_[index].parent == NO_PARENT) ? NO_PARENT : this->nodes_[index].subtree_end;
+		}
+
+		/**
+		 * Checks if node at ancestor index is ancestor of node at index (or node itself)
+		 */
+		bool is_in_subtree(const size_t ancestor, const size_t index) const {
+			return ancestor <= index && index < this->nodes_[ancestor].subtree_end;
+		}
+
+		/**
+		 * Calls operation with item of every node of subtree, in pre-order
+		 *
+		 * \tparam UnaryOperation : callable (ItemType&)
+		 * \param index : root of subtree
+		 */
+		template<typename UnaryOperation>
+		void for_each_in_subtree(const size_t index, UnaryOperation operation) {
+			for (size_t current = index, end = this->nodes_[index].subtree_end; current < end; ++current) {
+				operation(this->nodes_[current].item);
+			}
+		}
+
+		/**
+		 * Calls operation with item of every ancestor of node, from parent up to root
+		 *
+		 * \tparam UnaryOperation : callable (ItemType&)
+		 * \param index : node whose ancestors are visited
+		 */
+		template<typename UnaryOperation>
+		void for_each_ancestor(const size_t index, UnaryOperation operation) {
+			for (size_t current = this->nodes_[index].parent; current != NO_PARENT; current = this->nodes_[current].parent) {
+				operation(this->nodes_[current].item);
+			}
+		}
+
+		using Iterator = typename ArrayList<Node, NodeAllocatorType>::ConstIterator;
+
+		/**
+		 * Iterates over every node in pre-order
+		 */
+		Iterator begin() const {
+			return this->nodes_.begin();
+		}
+
+		Iterator end() const {
+			return this->nodes_.end();
+		}
+	};
+};
+
+
+#endif //FROZENTREE_H
@@ -0,0 +1,142 @@
+#ifndef HASHING_H
+#define HASHING_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+namespace Containers {
+	namespace Hashing {
+		constexpr uint64_t SECRET_0 = 0xa0761d6478bd642full;
+		constexpr uint64_t SECRET_1 = 0xe7037ed1a0b428dbull;
+		constexpr uint64_t SECRET_2 = 0x8ebc6af09c88c6e3ull;
+
+		/**
+		 * Multiplies two numbers into 128 bit result and folds it back into 64 bits (both halves are xored)
+		 */
+		inline uint64_t multiply_fold(const uint64_t left, const uint64_t right) {
+#if defined(__SIZEOF_INT128__)
+			auto result = static_cast<unsigned __int128>(left) * right;
+			return static_cast<uint64_t>(result) ^ static_cast<uint64_t>(result >> 64);
+#else
+			// schoolbook multiplication of 32 bit halves
+			uint64_t left_high = left >> 32, left_low = static_cast<uint32_t>(left);
+			uint64_t right_high = right >> 32, right_low = static_cast<uint32_t>(right);
+
+			uint64_t high_high = left_high * right_high;
+			uint64_t high_low = left_high * right_low;
+			uint64_t low_high = left_low * right_high;
+			uint64_t low_low = left_low * right_low;
+
+			uint64_t middle = (low_low >> 32) + static_cast<uint32_t>(high_low) + static_cast<uint32_t>(low_high);
+			uint64_t low = (middle << 32) | static_cast<uint32_t>(low_low);
+			uint64_t high = high_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32);
+
+			return low ^ high;
+#endif
+		}
+
+		inline uint64_t read_64(const char* data) {
+			uint64_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		inline uint64_t read_32(const char* data) {
+			uint32_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		/**
+		 * Hashes sequence of bytes. Input is consumed 16 bytes at once and mixed by 128 bit multiplication
+		 * (wyhash style), so short keys like names of towns need only few multiplications.
+		 *
+		 * \param data : first byte of sequence
+		 * \param size : number of bytes in sequence
+		 * \param seed : changes hash of every sequence
+		 */
+		inline uint64_t hash_bytes(const char* data, size_t size, const uint64_t seed = 0) {
+			uint64_t state = seed ^ multiply_fold(seed ^ SECRET_0, SECRET_1);
+			const uint64_t length = size;
+
+			while (size > 16) {
+				state = multiply_fold(read_64(data) ^ SECRET_1, read_64(data + 8) ^ state);
+				data += 16;
+				size -= 16;
+			}
+
+			// last 1 - 16 bytes - longer tails are read as two overlapping words
+			uint64_t first = 0, second = 0;
+			if (size >= 8) {
+				first = read_64(data);
+				second = read_64(data + size - 8);
+			}
+			else if (size >= 4) {
+				first = read_32(data);
+				second = read_32(data + size - 4);
+			}
+			else if (size > 0) {
+				first = (static_cast<uint64_t>(static_cast<unsigned char>(data[0])) << 16)
+					| (static_cast<uint64_t>(static_cast<unsigned char>(data[size >> 1])) << 8)
+					| static_cast<uint64_t>(static_cast<unsigned char>(data[size - 1]));
+			}
+
+			return multiply_fold(SECRET_2 ^ length, multiply_fold(first ^ SECRET_1, second ^ state));
+		}
+	}
+
+	/**
+	 * Hash of strings. It is transparent - std::string, std::string_view and character arrays
+	 * have same hash when their content is same, so tables can be searched by any of them.
+	 */
+	struct StringHash {
+		using is_transparent = void;
+
+		size_t operator()(std::string_view value) const {
+			return static_cast<size_t>(Hashing::hash_bytes(value.data(), value.size()));
+		}
+	};
+
+	/**
+	 * Comparator of strings which accepts any type convertible to std::string_view
+	 */
+	struct StringEqual {
+		using is_transparent = void;
+
+		bool operator()(std::string_view left, std::string_view right) const {
+			return left == right;
+		}
+	};
+
+	/**
+	 * Hash used by tables when no other is specified - strings use StringHash, everything else std::hash
+	 */
+	template<typename KeyType>
+	using DefaultHash = std::conditional_t<std::is_convertible_v<const KeyType&, std::string_view>, StringHash, std::hash<KeyType>>;
+
+	/**
+	 * Comparator used by tables when no other is specified - strings use StringEqual, everything else std::equal_to
+	 */
+	template<typename KeyType>
+	using DefaultKeyEqual = std::conditional_t<std::is_convertible_v<const KeyType&, std::string_view>, StringEqual, std::equal_to<KeyType>>;
+
+	/**
+	 * Checks if both hash and comparator accept other types than key type itself
+	 */
+	template<typename HashType, typename KeyEqualType, typename = void>
+	struct is_transparent_lookup : std::false_type {};
+
+	template<typename HashType, typename KeyEqualType>
+	struct is_transparent_lookup<HashType, KeyEqualType, std::void_t<typename HashType::is_transparent, typename KeyEqualType::is_transparent>> : std::true_type {};
+
+	/**
+	 * True when table with hash and comparator can be searched by LookupKeyType without converting it to KeyType
+	 */
+	template<typename KeyType, typename LookupKeyType, typename HashType, typename KeyEqualType>
+	inline constexpr bool accepts_lookup_key_v = std::is_same_v<std::decay_t<LookupKeyType>, KeyType> || is_transparent_lookup<HashType, KeyEqualType>::value;
+}
+
+#endif //HASHING_H
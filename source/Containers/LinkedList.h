@@ -3,6 +3,10 @@
 
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "ArenaAllocator.h"
 
 
 namespace Containers {
@@ -13,7 +17,8 @@ namespace Containers {
 			Node* next = nullptr;
 			ItemType value;
 
-			Node(const ItemType& value) : value(value) {};
+			template<typename... ArgumentTypes>
+			explicit Node(std::in_place_t, ArgumentTypes&&... arguments) : value(std::forward<ArgumentTypes>(arguments)...) {};
 		};
 
 		using MyType = LinkedList<ItemType, AllocatorType>;
@@ -27,14 +32,56 @@ namespace Containers {
 		Node* front_ = nullptr;
 		Node* back_ = nullptr;
 
-		// this is done in outer class so we don't need to pass allocator to node
-		void finishNode_(Node* node) {
-			if (node != nullptr) {
-				this->finishNode_(node->next);
+		// number of nodes - end() and size() don't have to walk the list
+		size_t size_ = 0;
+
+		// nodes whose items were already destroyed - new items reuse them before asking allocator for memory
+		Node* free_nodes_ = nullptr;
+
+		/**
+		 * Returns memory for new node - recycled node if there is one
+		 */
+		Node* acquire_node_() {
+			if (this->free_nodes_ != nullptr) {
+				Node* node = this->free_nodes_;
+				this->free_nodes_ = node->next;
+
+				return node;
+			}
+
+			return std::allocator_traits<NodeAllocatorType>::allocate(this->nodeAllocator_, 1);
+		}
+
+		/**
+		 * Destroys item of node and puts node into free list
+		 */
+		void recycle_node_(Node* node) {
+			std::destroy_at(&node->value);
+
+			node->next = this->free_nodes_;
+			this->free_nodes_ = node;
+		}
+
+		/**
+		 * Destroys every node and returns memory of nodes (including free ones) to allocator. Doesn't use recursion.
+		 * This is done in outer class so we don't need to pass allocator to node.
+		 */
+		void release_nodes_() {
+			Node* node = this->front_;
+			while (node != nullptr) {
+				Node* next = node->next;
 
 				std::allocator_traits<NodeAllocatorType>::destroy(this->nodeAllocator_, node);
 				std::allocator_traits<NodeAllocatorType>::deallocate(this->nodeAllocator_, node, 1);
+
+				node = next;
 			}
+
+			this->front_ = nullptr;
+			this->back_ = nullptr;
+			this->size_ = 0;
+
+			this->shrink_to_fit();
 		}
 
 	public:
@@ -52,35 +99,68 @@ namespace Containers {
 		LinkedList(const AllocatorType& allocator) : itemAllocator_(allocator), nodeAllocator_(this->itemAllocator_) {};
 
 
+		/**
+		 * Creates list with copies of items of other list. Copy uses same allocator as other list.
+		 */
 		LinkedList(const MyType& other) : itemAllocator_(other.itemAllocator_), nodeAllocator_(other.nodeAllocator_) {
-			if (other.front_ == nullptr) {
-				return;
+			for (auto node = other.front_; node != nullptr; node = node->next) {
+				this->emplace_back(node->value);
 			}
+		};
 
-			auto other_first_node = other.front_;
+		/**
+		 * Takes over nodes of other list. Other list is left empty.
+		 */
+		LinkedList(MyType&& other) noexcept : itemAllocator_(other.itemAllocator_), nodeAllocator_(other.nodeAllocator_), front_(other.front_), back_(other.back_), size_(other.size_) {
+			other.front_ = nullptr;
+			other.back_ = nullptr;
+			other.size_ = 0;
+		};
+
+		/**
+		 * Replaces items of list with copies of items of other list
+		 */
+		MyType& operator=(const MyType& other) {
+			if (this == &other) {
+				return *this;
+			}
 
-			auto this_first_node = std::allocator_traits<NodeAllocatorType>::allocate(this->nodeAllocator_, 1);
-			std::allocator_traits<NodeAllocatorType>::construct(this->nodeAllocator_, this_first_node, other_first_node->value);
+			this->clear();
+			for (auto node = other.front_; node != nullptr; node = node->next) {
+				this->push_back(node->value);
+			}
 
-			auto active_node = this_first_node;
+			return *this;
+		}
 
-			while (other_first_node->next != nullptr) {
-				other_first_node = other_first_node->next;
+		/**
+		 * Replaces items of list with nodes of other list. Other list is left empty.
+		 */
+		MyType& operator=(MyType&& other) noexcept {
+			if (this == &other) {
+				return *this;
+			}
 
-				active_node->next = std::allocator_traits<NodeAllocatorType>::allocate(this->nodeAllocator_, 1);
-				std::allocator_traits<NodeAllocatorType>::construct(this->nodeAllocator_, active_node, other_first_node->value);
+			this->clear();
 
-				active_node = active_node->next;
-			};
+			this->front_ = other.front_;
+			this->back_ = other.back_;
+			this->size_ = other.size_;
+			other.front_ = nullptr;
+			other.back_ = nullptr;
+			other.size_ = 0;
+
+			return *this;
+		}
 
-			this->front_ = this_first_node;
-			this->back_ = active_node;
-		};
 		/**
 		 * Destroys linked list
 		 */
 		~LinkedList() {
-			this->clear();
+			// nodes of bulk releasing allocator don't have to be returned one by one
+			if constexpr (not skips_teardown_v<NodeAllocatorType, ItemType>) {
+				this->release_nodes_();
+			}
 		}
 
 		/**
@@ -90,9 +170,28 @@ namespace Containers {
 		 * \return value : item that is now stored inside of list
 		 */
 		ItemType& push_back(const ItemType& value) {
+			return this->emplace_back(value);
+		}
+
+		/**
+		 * Constructs item directly at the back of list. Item doesn't have to be copyable.
+		 *
+		 * \param arguments : arguments passed to constructor of item
+		 * \return value : item that is now stored inside of list
+		 */
+		template<typename... ArgumentTypes>
+		ItemType& emplace_back(ArgumentTypes&&... arguments) {
 			// create new node
-			Node* newNode = std::allocator_traits<NodeAllocatorType>::allocate(this->nodeAllocator_, 1);
-			std::allocator_traits<NodeAllocatorType>::construct(this->nodeAllocator_, newNode, value);
+			Node* newNode = this->acquire_node_();
+			try {
+				std::allocator_traits<NodeAllocatorType>::construct(this->nodeAllocator_, newNode, std::in_place, std::forward<ArgumentTypes>(arguments)...);
+			}
+			catch (...) {
+				// memory of node is not lost - it waits for next item
+				newNode->next = this->free_nodes_;
+				this->free_nodes_ = newNode;
+				throw;
+			}
 
 			if (this->front_ == nullptr) {
 				this->front_ = newNode;
@@ -102,6 +201,7 @@ namespace Containers {
 				this->back_->next = newNode;
 				this->back_ = newNode;
 			}
+			++this->size_;
 
 			return newNode->value;
 		}
@@ -125,17 +225,48 @@ namespace Containers {
 			else {
 				this->front_ = this->front_->next;
 			}
+			--this->size_;
 
-			std::allocator_traits<NodeAllocatorType>::destroy(this->nodeAllocator_, tobeDeleted);
-			std::allocator_traits<NodeAllocatorType>::deallocate(this->nodeAllocator_, tobeDeleted, 1);
+			this->recycle_node_(tobeDeleted);
 		}
 
 
+		/**
+		 * Destroys every item. Nodes are kept in free list, so list can be filled again without allocating.
+		 */
 		void clear() {
-			this->finishNode_(this->front_);
+			if (this->front_ == nullptr) {
+				return;
+			}
+
+			if constexpr (std::is_trivially_destructible_v<ItemType>) {
+				// items need no destruction - whole chain of nodes becomes free list at once
+				this->back_->next = this->free_nodes_;
+				this->free_nodes_ = this->front_;
+			}
+			else {
+				Node* node = this->front_;
+				while (node != nullptr) {
+					Node* next = node->next;
+					this->recycle_node_(node);
+					node = next;
+				}
+			}
 
 			this->front_ = nullptr;
 			this->back_ = nullptr;
+			this->size_ = 0;
+		}
+
+		/**
+		 * Returns memory of free nodes to allocator
+		 */
+		void shrink_to_fit() {
+			while (this->free_nodes_ != nullptr) {
+				Node* next = this->free_nodes_->next;
+				std::allocator_traits<NodeAllocatorType>::deallocate(this->nodeAllocator_, this->free_nodes_, 1);
+				this->free_nodes_ = next;
+			}
 		}
 
 
@@ -144,8 +275,15 @@ namespace Containers {
 		 *
 		 * @return true if there are no items, false otherwise
 		 */
-		bool empty() {
-			return this->front_ == nullptr;
+		bool empty() const {
+			return this->size_ == 0;
+		}
+
+		/**
+		 * Returns number of items in list
+		 */
+		size_t size() const {
+			return this->size_;
 		}
 
 
@@ -174,15 +312,11 @@ namespace Containers {
 		* \throw std::out_of_range index is larger than number of nodes
 		*/
 		ItemType& at(const size_t index) {
-			Node* current = this->front_;
-
-			for (int counter = 0; counter < index; ++counter) {
-				if (current == nullptr) {
-					throw std::out_of_range("Index out of range.");
-				}
-				current = current->next;
+			if (index >= this->size_) {
+				throw std::out_of_range("Index out of range.");
 			}
-			return current->value;
+
+			return (*this)[index];
 		}
 
 		class Iterator {
@@ -258,17 +392,11 @@ namespace Containers {
 			return Iterator(this->front_, 0);
 		};
 
+		/**
+		 * Returns iterator behind last item - its index is size of list, so it can be compared by < with other iterators
+		 */
 		Iterator end() {
-			size_t index = 0;
-			Node* current = this->front_;
-			while (current != nullptr) {
-				++index;
-				current = current->next;
-			};
-
-
-
-			return Iterator(nullptr, index);
+			return Iterator(nullptr, this->size_);
 		};
 
 
@@ -2,8 +2,9 @@
 #define LINKEDLISTTREE_H
 
 #include <memory>
+#include <stdexcept>
 
-#include "LinkedList.h"
+#include "RingDeque.h"
 
 
 namespace Containers {
@@ -34,19 +35,28 @@ namespace Containers {
 		};
 
 		//* Finalization of node tree is in outer class because otherwise we would need to pass allocator to Node
+		//* Node, its descendants and its following siblings are destroyed without recursion - nodes waiting for destruction
+		//* form a stack linked through sibling links, children of destroyed node are put on top of it.
 		void finalizeNode_(Node* node) {
-			if (node == nullptr) {
-				return;
-			}
+			Node* pending = node;
 
-			this->finalizeNode_(node->children);
-			node->children = nullptr;
-			this->finalizeNode_(node->sibling);
-			node->sibling = nullptr;
+			while (pending != nullptr) {
+				Node* current = pending;
+				pending = current->sibling;
 
-			std::allocator_traits<NodeAllocatorType>::destroy(this->nodeAllocator_, node);
-			std::allocator_traits<NodeAllocatorType>::deallocate(this->nodeAllocator_, node);
+				if (current->children != nullptr) {
+					Node* lastChild = current->children;
+					while (lastChild->sibling != nullptr) {
+						lastChild = lastChild->sibling;
+					}
 
+					lastChild->sibling = pending;
+					pending = current->children;
+				}
+
+				std::allocator_traits<NodeAllocatorType>::destroy(this->nodeAllocator_, current);
+				std::allocator_traits<NodeAllocatorType>::deallocate(this->nodeAllocator_, current, 1);
+			}
 		}
 
 
@@ -78,7 +88,7 @@ namespace Containers {
 		* Destroys tree
 		*/
 		~LinkedListTree() {
-			this.finalizeNode_(this->root_);
+			this->finalizeNode_(this->root_);
 			this->root_ = nullptr;
 		}
 
@@ -87,9 +97,9 @@ namespace Containers {
 			Node* position_;
 			LinkedListTree& myTree_;
 
-			// NOTE: having std::list here is probably not allowed. Good think i made custom one
-			// "but it doesn't take allocator from Tree" ssshhh
-			Containers::LinkedList<Node*> queue_;
+			// NOTE: having std::deque here is probably not allowed. Good think i made custom one
+			// "but it doesn't take allocator from Tree" ssshhh - queue is only temporary state of iterator
+			Containers::RingDeque<Node*> queue_;
 		public:
 			using value_type		= ItemType;
 			using pointer			= ItemType*;
@@ -198,12 +208,12 @@ namespace Containers {
 				};
 
 
-				auto current = this->position_;
+				auto current = this->position_->children;
 
 				// iterate while current node isn't null
 				while (current != nullptr) {
 					// is selector happy? Move there
-					if (selector(*current)) {
+					if (selector(current->value)) {
 						this->position_ = current;
 						this->queue_.clear();
 						return true;
@@ -226,13 +236,14 @@ namespace Containers {
 			*/
 			void insert_children(ItemType& item) {
 				if (this->position_ == nullptr) {
-					throw std::out_of_range("Cannot insert children into non-existing node.")
+					throw std::out_of_range("Cannot insert children into non-existing node.");
 				};
 
 
 				// create new node
 				Node* newNode = std::allocator_traits<NodeAllocatorType>::allocate(myTree_.nodeAllocator_, 1);
 				std::allocator_traits<NodeAllocatorType>::construct(myTree_.nodeAllocator_, newNode, item);
+				newNode->parent = this->position_;
 
 				if (this->position_->children == nullptr) {
 					this->position_->children = newNode;
@@ -252,6 +263,14 @@ namespace Containers {
 
 		};
 
+		Iterator begin() {
+			return Iterator(this->root_, *this);
+		}
+
+		Iterator end() {
+			return Iterator(nullptr, *this);
+		}
+
 	};
 
 }
@@ -1,7 +1,15 @@
 #ifndef LINKEDTABLE_H
 #define LINKEDTABLE_H
+#include <cstdint>
 #include <functional>
+#include <iterator>
 #include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "ArenaAllocator.h"
+#include "Hashing.h"
 
 namespace Containers {
 	/**
@@ -11,20 +19,34 @@ namespace Containers {
 	 * \tparam KeyType : type of key object that identifies pair
 	 * \tparam ValueType : type of value stored in pair
 	 * \tparam AllocatorType : type of allocator used by table internally
+	 * \tparam HashType : hash of keys - if it and KeyEqualType are transparent, table can be searched by other types than KeyType
+	 * \tparam KeyEqualType : comparator of keys
 	 */
 	template <
 		typename KeyType,
 		typename ValueType,
-		typename AllocatorType = std::allocator<std::pair<const KeyType, ValueType>>
+		typename AllocatorType = std::allocator<std::pair<const KeyType, ValueType>>,
+		typename HashType = DefaultHash<KeyType>,
+		typename KeyEqualType = DefaultKeyEqual<KeyType>
 	>
 	class LinkedTable {
+		using MyType = LinkedTable<KeyType, ValueType, AllocatorType, HashType, KeyEqualType>;
 		using ItemType = std::pair<const KeyType, ValueType>;
 
 		struct Node {
 			Node* next = nullptr;
+
+			// mixed hash of key - table grows without hashing keys again and chains compare it before keys
+			size_t hash;
 			ItemType item;
 
-			Node(const ItemType& item) : item(item) {};
+			/**
+			 * Creates node whose value is constructed directly from arguments
+			 */
+			template<typename... ArgumentTypes>
+			Node(const size_t hash, const KeyType& key, ArgumentTypes&&... arguments)
+				: hash(hash), item(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<ArgumentTypes>(arguments)...)) {};
+
 			const KeyType& key() const { return item.first; }
 			ValueType& value() { return item.second; }
 		};
@@ -37,32 +59,51 @@ namespace Containers {
 		NodeListAllocatorType nodeListAllocator_;
 
 		// tools for key indexing and comparing
-		std::hash<KeyType> keyHash_;
-		std::equal_to<KeyType> keyEqual_;
+		HashType keyHash_;
+		KeyEqualType keyEqual_;
 
-		// array of buckets and information about it
+		// array of buckets and information about it - capacity is always power of two
 		Node** buckets_ = nullptr;
 		size_t capacity_ = 0;
 		size_t itemCount_ = 0;
 
+		/**
+		 * Returns hash of key folded with secret, so its lowest bits depend on every bit of hash.
+		 * Keys with weak hashes (e.g. aligned pointers, whose std::hash is their address) are then spread over all buckets by mask.
+		 */
+		template<typename LookupKeyType>
+		size_t mixed_hash_(const LookupKeyType& key) const {
+			return static_cast<size_t>(Hashing::multiply_fold(static_cast<uint64_t>(this->keyHash_(key)), Hashing::SECRET_0));
+		}
 
 		/**
-		* Checks if table is too full and expands it if needed
-		* NOTE: We actually don't need to destroy old nodes - we can reuse them with new buckets
-		*/
-		void resolve_fullness_() {
+		 * Returns bucket of mixed hash - capacity is power of two, so lowest bits are masked instead of modulo
+		 */
+		size_t bucket_index_(const size_t hash) const {
+			return hash & (this->capacity_ - 1);
+		}
+
+		/**
+		 * Checks if table with specified capacity can hold item count without growing
+		 */
+		static bool fits_(const size_t itemCount, const size_t capacity) {
 			// we will resize ONLY if item count is at least 80% of capacity
-			if (this->itemCount_ < static_cast<size_t>(this->capacity_ * 0.8)) {
-				return;
-			}
+			return itemCount < static_cast<size_t>(capacity * 0.8);
+		}
 
+		/**
+		 * Moves every node into new array of buckets
+		 * NOTE: We actually don't need to destroy old nodes - we can reuse them with new buckets
+		 *
+		 * \param capacity : new number of buckets - power of two
+		 */
+		void rehash_(const size_t capacity) {
 			// store old internals
 			Node** oldBuckets = this->buckets_;
 			size_t oldCapacity = this->capacity_;
 
 			// create new internals
-			this->itemCount_ = 0;
-			this->capacity_ = (oldCapacity == 0) ? 8 : (oldCapacity * 2);
+			this->capacity_ = capacity;
 			this->buckets_ = std::allocator_traits<NodeListAllocatorType>::allocate(this->nodeListAllocator_, this->capacity_);
 
 			// initialize new buckets into null (just in case)
@@ -77,14 +118,12 @@ namespace Containers {
 				while (current_node != nullptr) {
 					auto next_node = current_node->next;
 
-					// find nice new place for node in new buckets
-					auto new_location_index = this->find_node_(current_node->key()).first;
+					// find nice new place for node in new buckets - keys are unique, so there is no need to search chain
+					auto new_location_index = this->bucket_index_(current_node->hash);
 
 					current_node->next = this->buckets_[new_location_index];
 					this->buckets_[new_location_index] = current_node;
 
-					++this->itemCount_;
-
 					current_node = next_node;
 				};
 
@@ -92,25 +131,40 @@ namespace Containers {
 			};
 
 			// deallocate the old bucket array
-			std::allocator_traits<NodeListAllocatorType>::deallocate(this->nodeListAllocator_, oldBuckets, oldCapacity);
+			if (oldBuckets != nullptr) {
+				std::allocator_traits<NodeListAllocatorType>::deallocate(this->nodeListAllocator_, oldBuckets, oldCapacity);
+			}
+		};
+
+		/**
+		* Checks if table is too full and expands it if needed
+		*/
+		void resolve_fullness_() {
+			if (fits_(this->itemCount_, this->capacity_)) {
+				return;
+			}
+
+			this->rehash_((this->capacity_ == 0) ? 8 : (this->capacity_ * 2));
 		};
 
 		/**
 		 * Searches for node with same key as passed one. DOESN'T CHECK IF BUCKETS ARE EMPTY
 		 *
 		 * @param key key we are looking for
+		 * @param hash hash of key
 		 * @return <0, Node*> when node is found - Node* point at it
 		 * @return <index, nullptr> when node is not found - index specified best bucket to insert new node
 		 */
-		std::pair<int, Node*> find_node_(const KeyType& key) {
-			size_t index = this->keyHash_(key) % this->capacity_;
+		template<typename LookupKeyType>
+		std::pair<size_t, Node*> find_node_(const LookupKeyType& key, const size_t hash) const {
+			size_t index = this->bucket_index_(hash);
 
 			Node* activeNode = this->buckets_[index];
 
-			// if bucket node is not null, we need to check nodes there
+			// if bucket node is not null, we need to check nodes there - keys are compared only when hashes match
 			if (activeNode != nullptr) {
 				while (activeNode != nullptr) {
-					if (this->keyEqual_(key, activeNode->key())) {
+					if (activeNode->hash == hash && this->keyEqual_(key, activeNode->key())) {
 						return std::make_pair(0, activeNode);
 					}
 					activeNode = activeNode->next;
@@ -121,6 +175,19 @@ namespace Containers {
 			return std::make_pair(index, nullptr );
 		}
 
+		/**
+		 * Creates description of key for error messages. Only keys from which string can be constructed are described by their content.
+		 */
+		template<typename LookupKeyType>
+		static std::string describe_key_(const LookupKeyType& key) {
+			if constexpr (std::is_constructible_v<std::string, const LookupKeyType&>) {
+				return "Key '" + std::string(key) + "'";
+			}
+			else {
+				return "Key";
+			}
+		}
+
 		void finalize_node_(Node* node) {
 			std::allocator_traits<NodeAllocatorType>::destroy(this->nodeAllocator_, node);
 			std::allocator_traits<NodeAllocatorType>::deallocate(this->nodeAllocator_, node, 1);
@@ -139,18 +206,43 @@ namespace Containers {
 
 		LinkedTable(const AllocatorType& allocator) : nodeAllocator_(allocator), nodeListAllocator_(this->nodeAllocator_) {};
 
-		LinkedTable(const LinkedTable<KeyType, ValueType, AllocatorType>& other) {
-			throw std::runtime_error("Not implemented.");
+		/**
+		 * Creates table with copies of every pair of other table. Copy uses same allocator as other table.
+		 */
+		LinkedTable(const MyType& other)
+			: nodeAllocator_(other.nodeAllocator_), nodeListAllocator_(other.nodeListAllocator_), keyHash_(other.keyHash_), keyEqual_(other.keyEqual_) {
+			if (other.itemCount_ == 0) {
+				return;
+			}
+
+			this->rehash_(other.capacity_);
+
+			for (size_t index = 0; index < other.capacity_; ++index) {
+				for (Node* other_node = other.buckets_[index]; other_node != nullptr; other_node = other_node->next) {
+					Node* new_node = std::allocator_traits<NodeAllocatorType>::allocate(this->nodeAllocator_, 1);
+					std::allocator_traits<NodeAllocatorType>::construct(this->nodeAllocator_, new_node, other_node->hash, other_node->key(), other_node->item.second);
+
+					new_node->next = this->buckets_[index];
+					this->buckets_[index] = new_node;
+				}
+			}
+
+			this->itemCount_ = other.itemCount_;
 		};
 
+		MyType& operator=(const MyType& other) = delete;
+
 		~LinkedTable() {
 			if (this->buckets_ == nullptr) {
 				return;
 			}
 
-			for (size_t index = 0; index < this->capacity_; ++index) {
-				if (this->buckets_[index] != nullptr) {
-					this->finalize_node_chain_(this->buckets_[index]);
+			// nodes of bulk releasing allocator don't have to be destroyed one by one
+			if constexpr (not skips_teardown_v<NodeAllocatorType, ItemType>) {
+				for (size_t index = 0; index < this->capacity_; ++index) {
+					if (this->buckets_[index] != nullptr) {
+						this->finalize_node_chain_(this->buckets_[index]);
+					}
 				}
 			}
 			std::allocator_traits<NodeListAllocatorType>::deallocate(this->nodeListAllocator_, this->buckets_, this->capacity_);
@@ -158,64 +250,282 @@ namespace Containers {
 			this->itemCount_ = 0;
 		};
 
-		ValueType& insert(const KeyType& key, const ValueType& value) {
-			this->resolve_fullness_();
-
-			auto find_result = this->find_node_(key);
-			if (find_result.second != nullptr) {
-				throw std::out_of_range("Key '" + key + "' already exists.");
+		/**
+		 * Inserts value constructed from arguments, but only if key is not in table yet. Key is searched only once.
+		 *
+		 * \param key : key of inserted value
+		 * \param arguments : arguments passed to constructor of value - they are not used when key already exists
+		 * \return <value, true> when value was inserted, <existing value, false> when key already exists
+		 */
+		template<typename... ArgumentTypes>
+		std::pair<ValueType*, bool> try_emplace(const KeyType& key, ArgumentTypes&&... arguments) {
+			auto hash = this->mixed_hash_(key);
+
+			if (this->buckets_ != nullptr) {
+				auto find_result = this->find_node_(key, hash);
+				if (find_result.second != nullptr) {
+					return std::make_pair(&find_result.second->value(), false);
+				}
 			}
 
+			this->resolve_fullness_();
+			auto index = this->bucket_index_(hash);
+
 			Node* new_node = std::allocator_traits<NodeAllocatorType>::allocate(this->nodeAllocator_, 1);
-			std::allocator_traits<NodeAllocatorType>::construct(this->nodeAllocator_, new_node, std::make_pair(key, value));
+			std::allocator_traits<NodeAllocatorType>::construct(this->nodeAllocator_, new_node, hash, key, std::forward<ArgumentTypes>(arguments)...);
 
-			new_node->next = this->buckets_[find_result.first];
-			this->buckets_[find_result.first] = new_node;
+			new_node->next = this->buckets_[index];
+			this->buckets_[index] = new_node;
 
 			++this->itemCount_;
 
-			return new_node->value();
+			return std::make_pair(&new_node->value(), true);
+		};
+
+		/**
+		 * Returns value stored under key. If there is none, it is constructed from arguments first.
+		 *
+		 * \param key : key of requested value
+		 * \param arguments : arguments passed to constructor of value - they are not used when key already exists
+		 */
+		template<typename... ArgumentTypes>
+		ValueType& find_or_insert(const KeyType& key, ArgumentTypes&&... arguments) {
+			return *this->try_emplace(key, std::forward<ArgumentTypes>(arguments)...).first;
+		};
+
+		ValueType& insert(const KeyType& key, const ValueType& value) {
+			auto result = this->try_emplace(key, value);
+			if (not result.second) {
+				throw std::out_of_range(describe_key_(key) + " already exists.");
+			}
+
+			return *result.first;
+		};
+
+		ValueType& insert(const KeyType& key, ValueType&& value) {
+			auto result = this->try_emplace(key, std::move(value));
+			if (not result.second) {
+				throw std::out_of_range(describe_key_(key) + " already exists.");
+			}
+
+			return *result.first;
 		};
 
 		ValueType* try_insert(const KeyType& key, const ValueType& value) {
-			this->resolve_fullness_();
+			auto result = this->try_emplace(key, value);
+			return result.second ? result.first : nullptr;
+		};
+
+		ValueType* try_insert(const KeyType& key, ValueType&& value) {
+			auto result = this->try_emplace(key, std::move(value));
+			return result.second ? result.first : nullptr;
+		};
 
-			auto find_result = this->find_node_(key);
-			if (find_result.second != nullptr) {
+		/**
+		 * Removes pair with specified key
+		 *
+		 * \param key : key of removed pair
+		 * \return true if pair was removed, false if table doesn't contain key
+		 */
+		template<typename LookupKeyType, typename = std::enable_if_t<accepts_lookup_key_v<KeyType, LookupKeyType, HashType, KeyEqualType>>>
+		bool erase(const LookupKeyType& key) {
+			if (this->buckets_ == nullptr) {
+				return false;
+			}
+
+			auto hash = this->mixed_hash_(key);
+			Node** link = &this->buckets_[this->bucket_index_(hash)];
+
+			while (*link != nullptr) {
+				Node* node = *link;
+
+				if (node->hash == hash && this->keyEqual_(key, node->key())) {
+					*link = node->next;
+					this->finalize_node_(node);
+					--this->itemCount_;
+
+					return true;
+				}
+
+				link = &node->next;
+			}
+
+			return false;
+		};
+
+		bool erase(const KeyType& key) {
+			return this->erase<KeyType>(key);
+		};
+
+		/**
+		 * Prepares table for specified number of items, so it doesn't have to grow while they are inserted
+		 */
+		void reserve(const size_t itemCount) {
+			size_t capacity = (this->capacity_ == 0) ? 8 : this->capacity_;
+			while (not fits_(itemCount, capacity)) {
+				capacity *= 2;
+			}
+
+			if (capacity > this->capacity_) {
+				this->rehash_(capacity);
+			}
+		};
+
+		/**
+		 * Searches for value stored under key. Doesn't throw when key is missing.
+		 *
+		 * \param key : key of requested value
+		 * \return pointer to value, nullptr if table doesn't contain key
+		 */
+		ValueType* find(const KeyType& key) {
+			return this->find<KeyType>(key);
+		};
+
+		const ValueType* find(const KeyType& key) const {
+			return this->find<KeyType>(key);
+		};
+
+		/**
+		 * Searches for value stored under key of other type (e.g. std::string in table with std::string_view keys).
+		 * Key is not converted, so no temporary is created. Available only with transparent hash and comparator.
+		 *
+		 * \param key : key of requested value
+		 * \return pointer to value, nullptr if table doesn't contain key
+		 */
+		template<typename LookupKeyType, typename = std::enable_if_t<accepts_lookup_key_v<KeyType, LookupKeyType, HashType, KeyEqualType>>>
+		ValueType* find(const LookupKeyType& key) {
+			if (this->buckets_ == nullptr) {
 				return nullptr;
 			}
 
-			Node* new_node = std::allocator_traits<NodeAllocatorType>::allocate(this->nodeAllocator_, 1);
-			std::allocator_traits<NodeAllocatorType>::construct(this->nodeAllocator_, new_node, std::make_pair(key, value));
+			auto find_result = this->find_node_(key, this->mixed_hash_(key));
+			if (find_result.second == nullptr) {
+				return nullptr;
+			}
 
-			new_node->next = this->buckets_[find_result.first];
-			this->buckets_[find_result.first] = new_node;
+			return &find_result.second->value();
+		};
 
-			++this->itemCount_;
+		template<typename LookupKeyType, typename = std::enable_if_t<accepts_lookup_key_v<KeyType, LookupKeyType, HashType, KeyEqualType>>>
+		const ValueType* find(const LookupKeyType& key) const {
+			if (this->buckets_ == nullptr) {
+				return nullptr;
+			}
 
-			return &new_node->value();
+			auto find_result = this->find_node_(key, this->mixed_hash_(key));
+			if (find_result.second == nullptr) {
+				return nullptr;
+			}
+
+			return &find_result.second->value();
 		};
+
 		ValueType& at(const KeyType& key) {
-			auto find_result = this->find_node_(key);
-			if (find_result.second == nullptr) {
-				throw std::out_of_range("Key '" + key + "' doesn't exists.");
+			return this->at<KeyType>(key);
+		};
+
+		template<typename LookupKeyType, typename = std::enable_if_t<accepts_lookup_key_v<KeyType, LookupKeyType, HashType, KeyEqualType>>>
+		ValueType& at(const LookupKeyType& key) {
+			auto value = this->find(key);
+			if (value == nullptr) {
+				throw std::out_of_range(describe_key_(key) + " doesn't exists.");
 			}
 
-			return find_result.second->value();
+			return *value;
 		};
 
 		ValueType& at(const KeyType& key) const {
-			auto find_result = this->find_node_(key);
+			auto find_result = (this->buckets_ == nullptr) ? std::make_pair(size_t(0), static_cast<Node*>(nullptr)) : this->find_node_(key, this->mixed_hash_(key));
 			if (find_result.second == nullptr) {
-				throw std::out_of_range("Key '" + key + "' doesn't exists.");
+				throw std::out_of_range(describe_key_(key) + " doesn't exists.");
 			}
 
 			return find_result.second->value();
 		};
 
+		/**
+		 * Returns number of pairs in table
+		 */
+		size_t size() const {
+			return this->itemCount_;
+		}
+
+		bool empty() const {
+			return this->itemCount_ == 0;
+		}
+
+
+		/**
+		 * Represents forward iterator over pairs of table. Pairs are visited in order of buckets.
+		 */
+		class Iterator {
+			Node** buckets_;
+			size_t capacity_;
+			size_t index_;
+			Node* node_;
+
+			// moves to first node of next non-empty bucket (starting with current one)
+			void skip_empty_buckets_() {
+				while (this->node_ == nullptr && this->index_ < this->capacity_) {
+					this->node_ = this->buckets_[this->index_];
+					if (this->node_ == nullptr) {
+						++this->index_;
+					}
+				}
+			}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+
+			using value_type = ItemType;
+			using pointer = ItemType*;
+			using reference = ItemType&;
+			using difference_type = std::ptrdiff_t;
+
+			Iterator(Node** buckets, const size_t capacity, const size_t index) : buckets_(buckets), capacity_(capacity), index_(index), node_(nullptr) {
+				this->skip_empty_buckets_();
+			}
+
+			reference operator*() const {
+				return this->node_->item;
+			}
+
+			pointer operator->() const {
+				return &this->node_->item;
+			}
+
+			Iterator& operator++() {
+				this->node_ = this->node_->next;
+				if (this->node_ == nullptr) {
+					++this->index_;
+					this->skip_empty_buckets_();
+				}
+
+				return *this;
+			}
+
+			Iterator operator++(int) {
+				Iterator old = *this;
+				++(*this);
+				return old;
+			}
+
+			bool operator==(const Iterator& other) const {
+				return this->node_ == other.node_;
+			}
 
+			bool operator!=(const Iterator& other) const {
+				return this->node_ != other.node_;
+			}
+		};
 
+		Iterator begin() {
+			return Iterator(this->buckets_, this->capacity_, 0);
+		}
 
+		Iterator end() {
+			return Iterator(this->buckets_, this->capacity_, this->capacity_);
+		}
 	};
 
 }
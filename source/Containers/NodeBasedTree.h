@@ -1,9 +1,12 @@
 #ifndef NODEBASEDTREE_H
 #define NODEBASEDTREE_H
 
+#include <iterator>
 #include <memory>
 
-#include "LinkedList.h"
+#include "ArenaAllocator.h"
+#include "Hashing.h"
+#include "RingDeque.h"
 
 namespace Containers {
 	/**
@@ -14,6 +17,7 @@ namespace Containers {
 		using MyType = TreeNode<ItemType, AllocatorType>;
 
 		using NodeAllocatorType = typename std::allocator_traits<AllocatorType>::template rebind_alloc<MyType>;
+		using IndexAllocatorType = typename std::allocator_traits<AllocatorType>::template rebind_alloc<MyType*>;
 
 		NodeAllocatorType nodeAllocator_;
 
@@ -21,6 +25,16 @@ namespace Containers {
 		TreeNode* sibling_ = nullptr;
 		TreeNode* children_ = nullptr;
 
+		// last node of children chain - appending doesn't have to walk the chain
+		TreeNode* last_child_ = nullptr;
+		size_t child_count_ = 0;
+
+		// optional hash index of children (nullptr until it is built) - it has table for every key function it was built with,
+		// all tables have same power of two capacity and are stored one after another in single array
+		MyType** child_index_ = nullptr;
+		size_t child_index_capacity_ = 0;
+		size_t child_index_count_ = 0;
+
 		ItemType item_;
 
 		void finalize_node_(MyType* node) {
@@ -32,38 +46,259 @@ namespace Containers {
 			std::allocator_traits<NodeAllocatorType>::deallocate(this->nodeAllocator_, node, 1);
 		}
 
-	public:
-		explicit TreeNode(const ItemType& item, const AllocatorType& allocator = AllocatorType()) : nodeAllocator_(allocator), item_(item) {}
+		/**
+		 * Destroys every descendant and every following sibling of this node without recursion, so neither wide nor deep trees can overflow stack.
+		 * Nodes waiting for destruction form a stack linked through their sibling links - children of node taken from the stack
+		 * are pushed on top of it at once, by linking their last child to the rest of the stack.
+		 */
+		void release_linked_nodes_() {
+			MyType* pending = this->sibling_;
+			if (this->children_ != nullptr) {
+				this->last_child_->sibling_ = pending;
+				pending = this->children_;
+			}
 
-		~TreeNode() {
-			this->finalize_node_(this->children_);
-			this->finalize_node_(this->sibling_);
+			this->children_ = nullptr;
+			this->last_child_ = nullptr;
+			this->sibling_ = nullptr;
+			this->child_count_ = 0;
+
+			while (pending != nullptr) {
+				MyType* node = pending;
+				pending = node->sibling_;
+
+				if (node->children_ != nullptr) {
+					node->last_child_->sibling_ = pending;
+					pending = node->children_;
+				}
+
+				// node is unlinked, so its destructor has nothing left to destroy
+				node->children_ = nullptr;
+				node->last_child_ = nullptr;
+				node->sibling_ = nullptr;
+
+				this->finalize_node_(node);
+			}
 		}
 
+		/**
+		 * Returns index of first bucket where key is searched in table of child index
+		 */
+		template<typename KeyType>
+		size_t child_bucket_(const KeyType& key) const {
+			auto hash = static_cast<uint64_t>(DefaultHash<KeyType>()(key));
+			return static_cast<size_t>(Hashing::multiply_fold(hash, Hashing::SECRET_0)) & (this->child_index_capacity_ - 1);
+		}
 
-		MyType* push_back_children(const ItemType& item) {
+		/**
+		 * Inserts every child into table of child index, under key returned by key function
+		 */
+		template<typename KeyFunctionType>
+		void fill_child_table_(MyType** table, KeyFunctionType key_function) {
+			for (MyType* child = this->children_; child != nullptr; child = child->sibling_) {
+				size_t bucket = this->child_bucket_(key_function(child->item_));
+
+				// linear probing - table is at most half full, so free bucket is always near
+				while (table[bucket] != nullptr) {
+					bucket = (bucket + 1) & (this->child_index_capacity_ - 1);
+				}
+				table[bucket] = child;
+			}
+		}
+
+		/**
+		 * Returns memory of child index to allocator. Children are then searched by walking them again.
+		 */
+		void release_child_index_() {
+			if (this->child_index_ == nullptr) {
+				return;
+			}
+
+			IndexAllocatorType index_allocator(this->nodeAllocator_);
+			std::allocator_traits<IndexAllocatorType>::deallocate(index_allocator, this->child_index_, this->child_index_capacity_ * this->child_index_count_);
+
+			this->child_index_ = nullptr;
+			this->child_index_capacity_ = 0;
+			this->child_index_count_ = 0;
+		}
+
+		/**
+		 * Returns leftmost descendant of node which is exactly depth levels below it (node itself for depth 0), nullptr if there is none.
+		 * Subtree is walked through links of nodes and never deeper than depth.
+		 */
+		static MyType* first_at_depth_(MyType* node, const size_t depth) {
+			MyType* current = node;
+			size_t level = 0;
+
+			while (true) {
+				if (level == depth) {
+					return current;
+				}
+
+				if (current->children_ != nullptr) {
+					current = current->children_;
+					++level;
+					continue;
+				}
+
+				while (current != node && current->sibling_ == nullptr) {
+					current = current->parent_;
+					--level;
+				}
+
+				if (current == node) {
+					return nullptr;
+				}
+				current = current->sibling_;
+			}
+		}
+
+		/**
+		 * Finds node which follows position in level order of forest - forest is first node and (unless single_tree is set) its following siblings.
+		 * Nothing but links of nodes is used, so iterators built on this don't need queue.
+		 * Every step walks only nodes between position and the next one, which is cheap for shallow trees like hierarchy of land units.
+		 *
+		 * \param position : current node
+		 * \param depth : level of position below first node - it is increased when next node is on next level
+		 * \param first : first tree of forest
+		 * \param single_tree : siblings of first node are not part of forest
+		 * \return next node, nullptr if position is last node of forest
+		 */
+		static MyType* next_in_level_order_(MyType* position, size_t& depth, MyType* first, const bool single_tree) {
+			// next node on same level - it is under some following sibling of position or of its ancestors
+			MyType* node = position;
+			for (size_t up = 0; up < depth || (up == depth && not single_tree); ++up) {
+				for (MyType* sibling = node->sibling_; sibling != nullptr; sibling = sibling->sibling_) {
+					if (auto found = first_at_depth_(sibling, up)) {
+						return found;
+					}
+				}
+
+				if (up == depth) {
+					break;
+				}
+				node = node->parent_;
+			}
+
+			// level is finished - continue with first node of next level
+			++depth;
+			for (MyType* tree = first; tree != nullptr; tree = single_tree ? nullptr : tree->sibling_) {
+				if (auto found = first_at_depth_(tree, depth)) {
+					return found;
+				}
+			}
+
+			return nullptr;
+		}
+
+		/**
+		 * Creates node which isn't connected to any other node yet
+		 */
+		MyType* create_node_(const ItemType& item) {
 			MyType* newNode = std::allocator_traits<NodeAllocatorType>::allocate(this->nodeAllocator_, 1);
-			std::allocator_traits<NodeAllocatorType>::construct(this->nodeAllocator_, newNode, item);
+			try {
+				std::allocator_traits<NodeAllocatorType>::construct(this->nodeAllocator_, newNode, item, this->nodeAllocator_);
+			}
+			catch (...) {
+				std::allocator_traits<NodeAllocatorType>::deallocate(this->nodeAllocator_, newNode, 1);
+				throw;
+			}
 
 			// store myself as parent of the node
 			newNode->parent_ = this;
+			return newNode;
+		}
 
-			// has no children? Then this is our first one
+		/**
+		 * Appends chain of siblings behind last children
+		 *
+		 * \param first : first node of chain
+		 * \param last : last node of chain
+		 * \param count : number of nodes in chain
+		 */
+		void attach_chain_(MyType* first, MyType* last, const size_t count) {
+			// has no children? Then chain starts children
 			if (this->children_ == nullptr) {
-				this->children_ = newNode;
-				return newNode;
-			};
+				this->children_ = first;
+			}
+			else {
+				this->last_child_->sibling_ = first;
+			}
+
+			this->last_child_ = last;
+			this->child_count_ += count;
+
+			// index doesn't know new children
+			this->release_child_index_();
+		}
 
-			// has children? Go to the end and append it there
-			MyType* currentChildren = this->children_;
-			while (currentChildren->sibling_ != nullptr) {
-				currentChildren = currentChildren->sibling_;
+	public:
+		explicit TreeNode(const ItemType& item, const AllocatorType& allocator = AllocatorType()) : nodeAllocator_(allocator), item_(item) {}
+
+		~TreeNode() {
+			// nodes of bulk releasing allocator don't have to be destroyed one by one
+			if constexpr (not skips_teardown_v<NodeAllocatorType, ItemType>) {
+				this->release_child_index_();
+				this->release_linked_nodes_();
 			}
-			currentChildren->sibling_ = newNode;
+		}
+
+
+		/**
+		 * Creates node with item and appends it behind last children
+		 *
+		 * \param item : item of new node
+		 * \return new node
+		 */
+		MyType* push_back_children(const ItemType& item) {
+			MyType* newNode = this->create_node_(item);
+			this->attach_chain_(newNode, newNode, 1);
 
 			return newNode;
 		}
 
+		/**
+		 * Creates node for every item of range and appends all of them behind last children at once.
+		 * New nodes are in same order as items and they are last children of this node.
+		 * If creation of any node fails, no node is appended.
+		 *
+		 * \tparam InputIterType : iterator over items
+		 * \param begin : first item
+		 * \param end : end of items
+		 * \return first of new nodes (others follow as its siblings), nullptr if range is empty
+		 */
+		template<typename InputIterType>
+		MyType* push_back_children(InputIterType begin, InputIterType end) {
+			MyType* first = nullptr;
+			MyType* last = nullptr;
+			size_t count = 0;
+
+			try {
+				for (; begin != end; ++begin) {
+					MyType* newNode = this->create_node_(*begin);
+
+					if (first == nullptr) {
+						first = newNode;
+					}
+					else {
+						last->sibling_ = newNode;
+					}
+					last = newNode;
+					++count;
+				}
+			}
+			catch (...) {
+				this->finalize_node_(first);
+				throw;
+			}
+
+			if (first != nullptr) {
+				this->attach_chain_(first, last, count);
+			}
+
+			return first;
+		}
+
 		TreeNode* get_parent() const {
 			return this->parent_;
 		}
@@ -72,6 +307,87 @@ namespace Containers {
 			return this->children_;
 		}
 
+		TreeNode* get_sibling() const {
+			return this->sibling_;
+		}
+
+		/**
+		 * Builds hash index of children, so child with given key is found in constant time instead of walking all children.
+		 * Index has one table for every key function - table is later selected by position of its key function.
+		 * Index is dropped when new children is appended, so it should be built when tree is complete.
+		 *
+		 * \tparam KeyFunctionTypes : callables (const ItemType&) -> key, keys are hashed by DefaultHash
+		 * \param key_functions : functions returning keys of children
+		 */
+		template<typename... KeyFunctionTypes>
+		void build_child_index(KeyFunctionTypes... key_functions) {
+			static_assert(sizeof...(KeyFunctionTypes) > 0, "Child index needs at least one key function");
+
+			this->release_child_index_();
+
+			if (this->children_ == nullptr) {
+				return;
+			}
+
+			// at most half of buckets is used
+			size_t capacity = 4;
+			while (capacity < this->child_count_ * 2) {
+				capacity *= 2;
+			}
+
+			IndexAllocatorType index_allocator(this->nodeAllocator_);
+			MyType** index = std::allocator_traits<IndexAllocatorType>::allocate(index_allocator, capacity * sizeof...(KeyFunctionTypes));
+			for (size_t bucket = 0; bucket < capacity * sizeof...(KeyFunctionTypes); ++bucket) {
+				index[bucket] = nullptr;
+			}
+
+			this->child_index_ = index;
+			this->child_index_capacity_ = capacity;
+			this->child_index_count_ = sizeof...(KeyFunctionTypes);
+
+			size_t table = 0;
+			(this->fill_child_table_(index + capacity * table++, key_functions), ...);
+		}
+
+		/**
+		 * Finds children by key. Uses child index if it was built, otherwise walks all children.
+		 *
+		 * \param table : position of key function in build_child_index
+		 * \param key : searched key
+		 * \param key_function : same function that was used to build the table
+		 * \return children with key, nullptr if there is none
+		 */
+		template<typename KeyType, typename KeyFunctionType>
+		MyType* find_child(const size_t table, const KeyType& key, KeyFunctionType key_function) const {
+			if (table >= this->child_index_count_) {
+				for (MyType* child = this->children_; child != nullptr; child = child->sibling_) {
+					if (key_function(child->item_) == key) {
+						return child;
+					}
+				}
+				return nullptr;
+			}
+
+			MyType** buckets = this->child_index_ + this->child_index_capacity_ * table;
+			for (size_t bucket = this->child_bucket_(key); buckets[bucket] != nullptr; bucket = (bucket + 1) & (this->child_index_capacity_ - 1)) {
+				if (key_function(buckets[bucket]->item_) == key) {
+					return buckets[bucket];
+				}
+			}
+			return nullptr;
+		}
+
+		TreeNode* get_last_child() const {
+			return this->last_child_;
+		}
+
+		/**
+		 * Returns number of direct children
+		 */
+		size_t get_child_count() const {
+			return this->child_count_;
+		}
+
 		ItemType& get_item() {
 			return this->item_;
 		}
@@ -79,9 +395,16 @@ namespace Containers {
 
 
 
+		/**
+		 * Iterates level by level over node at which it started and over its following siblings. It can also move up and down the tree.
+		 * Iterator holds no queue - next node is found through links of nodes, so it is cheap to copy and never allocates.
+		 */
 		class Iterator {
 			MyType* position_;
-			Containers::LinkedList<MyType*, AllocatorType> queue_;
+
+			// node at which iteration started and level of position below it
+			MyType* first_;
+			size_t depth_ = 0;
 
 
 		public:
@@ -93,7 +416,7 @@ namespace Containers {
 			using difference_type = std::ptrdiff_t;
 
 
-			Iterator(MyType* position, const AllocatorType& allocator) : position_(position), queue_(allocator) {}
+			explicit Iterator(MyType* position) : position_(position), first_(position) {}
 
 
 			reference operator*() {
@@ -109,29 +432,7 @@ namespace Containers {
 					return *this;
 				}
 
-				// has current node any children?
-				if (this->position_->get_children() != nullptr) {
-					// true: put that children for later search
-					this->queue_.push_back(this->position_->get_children());
-				};
-
-				// has current node siblings after it?
-				if (this->position_->sibling_ != nullptr) {
-					// true: move to sibling
-					this->position_ = this->position_->sibling_;
-				}
-				else {
-					// false: check if queue is empty
-					if (this->queue_.empty()) {
-						// true: we are finished
-						this->position_ = nullptr;
-					}
-					else {
-						// false: move to top of queue
-						this->position_ = this->queue_[0];
-						this->queue_.pull_front();
-					};
-				};
+				this->position_ = next_in_level_order_(this->position_, this->depth_, this->first_, false);
 				return *this;
 			};
 
@@ -145,6 +446,13 @@ namespace Containers {
 
 
 
+			/**
+			 * Returns node at which iterator points
+			 */
+			MyType* get_node() const {
+				return this->position_;
+			}
+
 			/**
 			* Tries to move to the parent node
 			*
@@ -156,6 +464,10 @@ namespace Containers {
 					return false;
 				}
 				this->position_ = this->position_->get_parent();
+
+				// iteration starts again from new position
+				this->first_ = this->position_;
+				this->depth_ = 0;
 				return true;
 			};
 
@@ -182,7 +494,8 @@ namespace Containers {
 					// is predicate happy? Move there
 					if (predicate(*current)) {
 						this->position_ = current;
-						this->queue_.clear();
+						this->first_ = current;
+						this->depth_ = 0;
 						return true;
 					}
 					// it isn't happy? Move to next sibling and try
@@ -193,16 +506,230 @@ namespace Containers {
 				return false;
 			};
 
+			/**
+			 * Tries to move into children with given key - see find_child
+			 *
+			 * \param table : position of key function in build_child_index
+			 * \param key : key of children
+			 * \param key_function : same function that was used to build the table
+			 * \return true : move did happen - iterator now points at children
+			 * \return false : there is no children with key
+			 */
+			template<typename KeyType, typename KeyFunctionType>
+			bool move_to_children_by_key(const size_t table, const KeyType& key, KeyFunctionType key_function) {
+				if (this->position_ == nullptr) {
+					return false;
+				}
+
+				auto child = this->position_->find_child(table, key, key_function);
+				if (child == nullptr) {
+					return false;
+				}
+
+				this->position_ = child;
+				this->first_ = child;
+				this->depth_ = 0;
+				return true;
+			}
+
 
 
 		};
 
 		Iterator begin() {
-			return Iterator(this, this->nodeAllocator_);
+			return Iterator(this);
 		}
 
 		Iterator end() {
-			return Iterator(nullptr, this->nodeAllocator_);
+			return Iterator(nullptr);
+		}
+
+
+		/**
+		 * Iterates over subtree of one node in pre-order (depth first). Iterator never leaves subtree - siblings of its root are not visited.
+		 * Next node is found through links of nodes, so iterator holds only two pointers.
+		 */
+		class PreorderIterator {
+			MyType* position_ = nullptr;
+			MyType* root_ = nullptr;
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+
+			using value_type = ItemType;
+			using pointer = ItemType*;
+			using reference = ItemType&;
+			using difference_type = std::ptrdiff_t;
+
+
+			PreorderIterator() = default;
+
+			PreorderIterator(MyType* position, MyType* root) : position_(position), root_(root) {}
+
+			reference operator*() const {
+				return this->position_->item_;
+			}
+
+			pointer operator->() const {
+				return &this->position_->item_;
+			}
+
+			PreorderIterator& operator++() {
+				// has current node any children? First of them is next
+				if (this->position_->children_ != nullptr) {
+					this->position_ = this->position_->children_;
+					return *this;
+				}
+
+				// go up until some node has sibling - but never above root of subtree
+				while (this->position_ != this->root_ && this->position_->sibling_ == nullptr) {
+					this->position_ = this->position_->parent_;
+				}
+
+				this->position_ = (this->position_ == this->root_) ? nullptr : this->position_->sibling_;
+				return *this;
+			}
+
+			PreorderIterator operator++(int) {
+				auto old = *this;
+
+				++(*this);
+
+				return old;
+			}
+
+			bool operator==(const PreorderIterator& other) const {
+				return this->position_ == other.position_;
+			}
+
+			bool operator!=(const PreorderIterator& other) const {
+				return this->position_ != other.position_;
+			}
+
+			/**
+			 * Returns node at which iterator points
+			 */
+			MyType* get_node() const {
+				return this->position_;
+			}
+		};
+
+		/**
+		 * Iterates over subtree of one node level by level (breadth first). Iterator never leaves subtree - siblings of its root are not visited.
+		 * Like pre-order iterator, it holds no queue, so it is cheap to copy and never allocates.
+		 */
+		class LevelOrderIterator {
+			MyType* position_ = nullptr;
+			MyType* root_ = nullptr;
+
+			// level of position below root
+			size_t depth_ = 0;
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+
+			using value_type = ItemType;
+			using pointer = ItemType*;
+			using reference = ItemType&;
+			using difference_type = std::ptrdiff_t;
+
+
+			LevelOrderIterator() = default;
+
+			LevelOrderIterator(MyType* position, MyType* root) : position_(position), root_(root) {}
+
+			reference operator*() const {
+				return this->position_->item_;
+			}
+
+			pointer operator->() const {
+				return &this->position_->item_;
+			}
+
+			LevelOrderIterator& operator++() {
+				this->position_ = next_in_level_order_(this->position_, this->depth_, this->root_, true);
+				return *this;
+			}
+
+			LevelOrderIterator operator++(int) {
+				auto old = *this;
+
+				++(*this);
+
+				return old;
+			}
+
+			bool operator==(const LevelOrderIterator& other) const {
+				return this->position_ == other.position_;
+			}
+
+			bool operator!=(const LevelOrderIterator& other) const {
+				return this->position_ != other.position_;
+			}
+
+			/**
+			 * Returns node at which iterator points
+			 */
+			MyType* get_node() const {
+				return this->position_;
+			}
+		};
+
+		/**
+		 * Pair of iterators usable in range based for
+		 */
+		template<typename IteratorType>
+		class TraversalRange {
+			MyType* root_;
+
+		public:
+			explicit TraversalRange(MyType* root) : root_(root) {}
+
+			IteratorType begin() const {
+				return IteratorType(this->root_, this->root_);
+			}
+
+			IteratorType end() const {
+				return IteratorType(nullptr, this->root_);
+			}
+		};
+
+		/**
+		 * Returns range over this node and all its descendants in pre-order
+		 */
+		TraversalRange<PreorderIterator> preorder() {
+			return TraversalRange<PreorderIterator>(this);
+		}
+
+		/**
+		 * Returns range over this node and all its descendants level by level
+		 */
+		TraversalRange<LevelOrderIterator> level_order() {
+			return TraversalRange<LevelOrderIterator>(this);
+		}
+
+		/**
+		 * Calls operation with item of this node and of all its descendants level by level.
+		 * Frontier is kept in one ring buffer, so whole subtree is walked in linear time
+		 * (level order iterator holds no memory, but it has to search for first node of every next level).
+		 *
+		 * \tparam UnaryOperation : callable (ItemType&)
+		 */
+		template<typename UnaryOperation>
+		void for_each_in_level_order(UnaryOperation operation) {
+			RingDeque<MyType*> frontier;
+			frontier.push_back(this);
+
+			while (not frontier.empty()) {
+				MyType* node = frontier.front();
+				frontier.pull_front();
+
+				operation(node->item_);
+
+				for (MyType* child = node->children_; child != nullptr; child = child->sibling_) {
+					frontier.push_back(child);
+				}
+			}
 		}
 
 	};
@@ -0,0 +1,351 @@
+#ifndef RINGDEQUE_H
+#define RINGDEQUE_H
+
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace Containers {
+
+	/**
+	* Double ended queue stored in one contiguous array used as ring buffer.
+	* Items are added and removed at both ends in amortised constant time - memory is allocated only when array is full,
+	* so queue that is emptied and filled again (like frontier of tree search) doesn't allocate at all.
+	*
+	* \tparam ItemType : type of elements
+	* \tparam AllocatorType : allocator used for handling internal array
+	*/
+	template <typename ItemType, typename AllocatorType = std::allocator<ItemType>>
+	class RingDeque {
+		using MyType = RingDeque<ItemType, AllocatorType>;
+
+		// capacity of first allocated array
+		static constexpr size_t MINIMAL_CAPACITY = 16;
+
+		AllocatorType allocator_;
+
+		ItemType* items_ = nullptr;
+
+		// capacity is always zero or power of two, so position in array is masked instead of divided
+		size_t capacity_ = 0;
+
+		// position of first item in array
+		size_t head_ = 0;
+		size_t size_ = 0;
+
+		/**
+		 * Converts index of item in queue into position in array
+		 */
+		size_t position_(const size_t index) const {
+			return (this->head_ + index) & (this->capacity_ - 1);
+		}
+
+		/**
+		 * Moves items into new array with given capacity. Items are placed from the beginning of new array.
+		 *
+		 * \param capacity : power of two that is not smaller than size of queue
+		 */
+		void reallocate_(const size_t capacity) {
+			ItemType* items = std::allocator_traits<AllocatorType>::allocate(this->allocator_, capacity);
+
+			for (size_t index = 0; index < this->size_; ++index) {
+				ItemType& item = this->items_[this->position_(index)];
+
+				std::allocator_traits<AllocatorType>::construct(this->allocator_, &items[index], std::move_if_noexcept(item));
+				std::allocator_traits<AllocatorType>::destroy(this->allocator_, &item);
+			}
+
+			if (this->items_ != nullptr) {
+				std::allocator_traits<AllocatorType>::deallocate(this->allocator_, this->items_, this->capacity_);
+			}
+
+			this->items_ = items;
+			this->capacity_ = capacity;
+			this->head_ = 0;
+		}
+
+		/**
+		 * Constructs item from arguments and then doubles capacity of full array
+		 *
+		 * \return item that will be inserted into enlarged array
+		 */
+		template<typename... ArgumentTypes>
+		ItemType grow_with_(ArgumentTypes&&... arguments) {
+			ItemType item(std::forward<ArgumentTypes>(arguments)...);
+			this->reallocate_(this->capacity_ == 0 ? MINIMAL_CAPACITY : this->capacity_ * 2);
+
+			return item;
+		}
+
+		/**
+		 * Destroys every item and returns array to allocator
+		 */
+		void release_() {
+			this->clear();
+
+			if (this->items_ != nullptr) {
+				std::allocator_traits<AllocatorType>::deallocate(this->allocator_, this->items_, this->capacity_);
+			}
+
+			this->items_ = nullptr;
+			this->capacity_ = 0;
+		}
+
+	public:
+		/**
+		* Creates empty queue with default allocator. Nothing is allocated until first item is inserted.
+		*/
+		RingDeque() = default;
+
+		/**
+		* Creates empty queue using passed allocator
+		*
+		* \param allocator : allocator that will be used by collection
+		*/
+		explicit RingDeque(const AllocatorType& allocator) : allocator_(allocator) {}
+
+		/**
+		 * Creates queue with copies of items of other queue. Copy uses same allocator as other queue.
+		 */
+		RingDeque(const MyType& other) : allocator_(other.allocator_) {
+			for (size_t index = 0; index < other.size_; ++index) {
+				this->push_back(other[index]);
+			}
+		}
+
+		/**
+		 * Takes over array of other queue. Other queue is left empty.
+		 */
+		RingDeque(MyType&& other) noexcept : allocator_(other.allocator_), items_(other.items_), capacity_(other.capacity_), head_(other.head_), size_(other.size_) {
+			other.items_ = nullptr;
+			other.capacity_ = 0;
+			other.head_ = 0;
+			other.size_ = 0;
+		}
+
+		/**
+		 * Replaces items of queue with copies of items of other queue. Array of queue is reused when it is large enough.
+		 */
+		MyType& operator=(const MyType& other) {
+			if (this == &other) {
+				return *this;
+			}
+
+			this->clear();
+			for (size_t index = 0; index < other.size_; ++index) {
+				this->push_back(other[index]);
+			}
+
+			return *this;
+		}
+
+		/**
+		 * Replaces items of queue with array of other queue. Other queue is left empty.
+		 */
+		MyType& operator=(MyType&& other) noexcept {
+			if (this == &other) {
+				return *this;
+			}
+
+			this->release_();
+
+			this->items_ = other.items_;
+			this->capacity_ = other.capacity_;
+			this->head_ = other.head_;
+			this->size_ = other.size_;
+			other.items_ = nullptr;
+			other.capacity_ = 0;
+			other.head_ = 0;
+			other.size_ = 0;
+
+			return *this;
+		}
+
+		/**
+		* Destroys queue
+		*/
+		~RingDeque() {
+			this->release_();
+		}
+
+		/**
+		 * Inserts item to the back of queue
+		 *
+		 * \param value : item to be inserted
+		 * \return item that is now stored inside of queue
+		 */
+		ItemType& push_back(const ItemType& value) {
+			return this->emplace_back(value);
+		}
+
+		/**
+		 * Inserts item to the front of queue
+		 *
+		 * \param value : item to be inserted
+		 * \return item that is now stored inside of queue
+		 */
+		ItemType& push_front(const ItemType& value) {
+			return this->emplace_front(value);
+		}
+
+		/**
+		 * Constructs item directly at the back of queue
+		 *
+		 * \param arguments : arguments passed to constructor of item
+		 * \return item that is now stored inside of queue
+		 */
+		template<typename... ArgumentTypes>
+		ItemType& emplace_back(ArgumentTypes&&... arguments) {
+			if (this->size_ == this->capacity_) {
+				// arguments may refer to item of this queue, so item is created before old array is released
+				return this->emplace_back(this->grow_with_(std::forward<ArgumentTypes>(arguments)...));
+			}
+
+			ItemType* item = &this->items_[this->position_(this->size_)];
+			std::allocator_traits<AllocatorType>::construct(this->allocator_, item, std::forward<ArgumentTypes>(arguments)...);
+			++this->size_;
+
+			return *item;
+		}
+
+		/**
+		 * Constructs item directly at the front of queue
+		 *
+		 * \param arguments : arguments passed to constructor of item
+		 * \return item that is now stored inside of queue
+		 */
+		template<typename... ArgumentTypes>
+		ItemType& emplace_front(ArgumentTypes&&... arguments) {
+			if (this->size_ == this->capacity_) {
+				return this->emplace_front(this->grow_with_(std::forward<ArgumentTypes>(arguments)...));
+			}
+
+			size_t head = (this->head_ + this->capacity_ - 1) & (this->capacity_ - 1);
+			ItemType* item = &this->items_[head];
+			std::allocator_traits<AllocatorType>::construct(this->allocator_, item, std::forward<ArgumentTypes>(arguments)...);
+			this->head_ = head;
+			++this->size_;
+
+			return *item;
+		}
+
+		/**
+		 * Removes item from the front of queue
+		 *
+		 * \throw std::out_of_range : queue is empty
+		 */
+		void pull_front() {
+			if (this->size_ == 0) {
+				throw std::out_of_range("Cannot pull from empty queue.");
+			}
+
+			std::allocator_traits<AllocatorType>::destroy(this->allocator_, &this->items_[this->head_]);
+			this->head_ = this->position_(1);
+			--this->size_;
+		}
+
+		/**
+		 * Removes item from the back of queue
+		 *
+		 * \throw std::out_of_range : queue is empty
+		 */
+		void pull_back() {
+			if (this->size_ == 0) {
+				throw std::out_of_range("Cannot pull from empty queue.");
+			}
+
+			std::allocator_traits<AllocatorType>::destroy(this->allocator_, &this->items_[this->position_(this->size_ - 1)]);
+			--this->size_;
+		}
+
+		/**
+		 * Returns first item of queue. Doesn't check if queue is empty.
+		 */
+		ItemType& front() {
+			return this->items_[this->head_];
+		}
+
+		/**
+		 * Returns last item of queue. Doesn't check if queue is empty.
+		 */
+		ItemType& back() {
+			return this->items_[this->position_(this->size_ - 1)];
+		}
+
+		/**
+		* Returns reference to item at specified index, counted from the front. Doesn't perform bound checking.
+		*
+		* \param index : index of requested item.
+		*/
+		ItemType& operator[](const size_t index) {
+			return this->items_[this->position_(index)];
+		}
+
+		/**
+		* Returns constant reference to item at specified index, counted from the front. Doesn't perform bound checking.
+		*
+		* \param index : index of requested item.
+		*/
+		const ItemType& operator[](const size_t index) const {
+			return this->items_[this->position_(index)];
+		}
+
+		/**
+		 * Destroys every item. Array is kept, so queue can be filled again without allocating.
+		 */
+		void clear() {
+			if constexpr (not std::is_trivially_destructible_v<ItemType>) {
+				for (size_t index = 0; index < this->size_; ++index) {
+					std::allocator_traits<AllocatorType>::destroy(this->allocator_, &this->items_[this->position_(index)]);
+				}
+			}
+
+			this->head_ = 0;
+			this->size_ = 0;
+		}
+
+		/**
+		 * Makes sure that queue can hold at least given number of items without allocating
+		 *
+		 * \param capacity : expected number of items
+		 */
+		void reserve(const size_t capacity) {
+			if (capacity <= this->capacity_) {
+				return;
+			}
+
+			size_t new_capacity = (this->capacity_ == 0) ? MINIMAL_CAPACITY : this->capacity_;
+			while (new_capacity < capacity) {
+				new_capacity *= 2;
+			}
+
+			this->reallocate_(new_capacity);
+		}
+
+		/**
+		 * Checks if queue is empty
+		 */
+		bool empty() const {
+			return this->size_ == 0;
+		}
+
+		/**
+		 * Returns number of items in queue
+		 */
+		size_t size() const {
+			return this->size_;
+		}
+
+		/**
+		 * Returns number of items queue can hold before it has to allocate
+		 */
+		size_t capacity() const {
+			return this->capacity_;
+		}
+	};
+};
+
+
+#endif //RINGDEQUE_H
@@ -1,30 +1,77 @@
 #ifndef CSVLINEREADER_H
 #define CSVLINEREADER_H
 
-#include <sstream>
-#include <fstream>
-#include <string>
+#include <charconv>
+#include <cstring>
+#include <optional>
+#include <string_view>
 
 namespace DataHandling {
+	/**
+	 * Reads fields of one csv line. Line is scanned only once, from left to right,
+	 * and fields are passed as views into the line, so line must outlive the reader.
+	 */
 	class CsvLineReader {
-		std::stringstream lineStream;
+		const char* position_;
+		const char* end_;
+
+		std::string_view next_field_() {
+			if (this->position_ == nullptr) {
+				return {};
+			}
+
+			// memchr is vectorized by standard library, so separator is searched in several characters at once
+			auto separator = static_cast<const char*>(std::memchr(this->position_, ';', this->end_ - this->position_));
+
+			if (separator == nullptr) {
+				auto field = std::string_view(this->position_, this->end_ - this->position_);
+				this->position_ = nullptr;
+				return field;
+			}
+
+			auto field = std::string_view(this->position_, separator - this->position_);
+			this->position_ = separator + 1;
+			return field;
+		}
 
 	public:
-		explicit CsvLineReader(const std::string& line) : lineStream(line) { }
+		explicit CsvLineReader(std::string_view line) : position_(line.data()), end_(line.data() + line.size()) {
+			if (this->position_ == nullptr) {
+				this->end_ = nullptr;
+			}
+		}
 
 		CsvLineReader* skipField() {
-			std::string field;
-			getline(this->lineStream, field, ';');
+			this->next_field_();
 
 			return this;
 		}
 
 		template<typename OperationType>
 		CsvLineReader* handleField(OperationType operation) {
-			std::string field;
-			getline(this->lineStream, field, ';');
+			operation(this->next_field_());
+
+			return this;
+		}
+
+		/**
+		 * Parses next field as integer and passes it to operation
+		 *
+		 * \param operation : receives std::optional<int> - it is empty when whole field is not a number
+		 */
+		template<typename OperationType>
+		CsvLineReader* handleIntField(OperationType operation) {
+			auto field = this->next_field_();
+
+			int value = 0;
+			auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
 
-			operation(field);
+			if (error != std::errc() || end != field.data() + field.size() || field.empty()) {
+				operation(std::optional<int>());
+			}
+			else {
+				operation(std::optional<int>(value));
+			}
 
 			return this;
 		}
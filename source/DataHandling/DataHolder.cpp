@@ -1,234 +1,451 @@
+#include <charconv>
 #include <iostream>
-#include <fstream>
+#include <filesystem>
+#include <future>
 
 #include "CsvLineReader.h"
+#include "MappedFile.h"
 #include "DataHolder.h"
 
+#include "../Containers/ArrayList.h"
+
+#include "../Algorithms/Sorting.h"
+
 
 /**
-* Job of this is to just add population into all parent nodes
+* Strips angle brackets from identifier - <AT111> becomes AT111
 */
-void add_population_(Containers::TreeNode<DataHandling::LandUnitData*>* node, int category, size_t year_index, int population) {
-	if (node == nullptr) {
-		return;
+std::string_view restrict_identifier_(std::string_view identifier) {
+	return identifier.substr(1, identifier.size() - 2);
+}
+
+/**
+* Adds populations of every unit into its parent. Units are visited from the end of pre-order array,
+* so every unit already holds total of its subtree when it is added into parent.
+* Only towns have their own populations, so after this every upper unit holds total of its subtree.
+*/
+void aggregate_population_(const DataHandling::DataHolder::FrozenHierarchyType& hierarchy) {
+	for (size_t index = hierarchy.size(); index-- > 1;) {
+		auto unit = hierarchy[index].item;
+		auto parent_unit = hierarchy[hierarchy[index].parent].item;
+
+		for (size_t year_index = 0; year_index < unit->get_population_years().size(); ++year_index) {
+			parent_unit->male_population_at(year_index) += unit->male_population_at(year_index);
+			parent_unit->female_population_at(year_index) += unit->female_population_at(year_index);
+		}
+	}
+}
+
+/**
+* One parsed line of year file
+*/
+struct PopulationRow_ {
+	std::string_view restricted_id;
+	int male_population = 0;
+	int female_population = 0;
+
+	// false when populations are not numbers
+	bool is_valid = true;
+};
+
+// tables of child index of every node
+constexpr size_t CHILD_BY_NAME_ = 0;
+constexpr size_t CHILD_BY_IDENTIFIER_ = 1;
+
+std::string_view unit_name_(DataHandling::LandUnitData* const& unit) {
+	return unit->get_name();
+}
+
+std::string_view unit_identifier_(DataHandling::LandUnitData* const& unit) {
+	return unit->get_identifier();
+}
+
+/**
+* Loads populations of one year into towns. Every row is joined with its town by its identifier,
+* so rows can be in any order and file doesn't need to contain every town. Rows of units other than towns are skipped.
+*
+* Function only reads from mapper and writes only into column of its own year,
+* so files of different years can be loaded on separate threads.
+*
+* \return number of rows read (every row is looked up in mapper once)
+*/
+size_t load_population_file_(const DataHandling::MappedFile& file, const size_t year_index, const DataHandling::DataHolder::IdentifierIndexType& identifier_index) {
+	size_t row_count = 0;
+
+	for (auto line : file.lines()) {
+		PopulationRow_ row;
+		++row_count;
+
+		DataHandling::CsvLineReader(line)
+			.skipField()
+			->handleField([&row](std::string_view field ) {
+				row.restricted_id = restrict_identifier_(field);
+			})
+			->handleIntField([&row](std::optional<int> value ) {
+				row.male_population = value.value_or(0);
+				row.is_valid = row.is_valid && value.has_value();
+			})
+			->skipField()
+			->handleIntField([&row](std::optional<int> value ) {
+				row.female_population = value.value_or(0);
+				row.is_valid = row.is_valid && value.has_value();
+			});
+
+		// find town of this row - only one item won't be found: "Nicht klassifizierbar"
+		// i don't know what job it has, but it is not used anwyhere, soo...
+		// index holds units of every level - row of upper unit would be counted twice by rollup
+		auto town_node = identifier_index.find(row.restricted_id);
+		if (town_node == nullptr || not (*town_node)->get_item()->is_town()) {
+			continue;
+		}
+
+		if (not row.is_valid) {
+			throw std::runtime_error("Population of town is not a number.");
+		}
+
+		auto town = (*town_node)->get_item();
+		town->male_population_at(year_index) = row.male_population;
+		town->female_population_at(year_index) = row.female_population;
 	}
 
-	add_population_(node->get_parent(), category, year_index, population);
+	return row_count;
+}
+
+/**
+* Population file of one year together with task which loads it
+*/
+struct YearFile_ {
+	size_t year_index;
+	DataHandling::MappedFile file;
+	std::future<size_t> loading_task;
+
+	YearFile_(const size_t year_index, const std::string& path) : year_index(year_index), file(path) {}
+};
+
+DataHandling::DataHolder::DataHolder(const std::string& data_directory) : data_directory_(data_directory) {
+	const auto snapshot_path = this->data_path_("snapshot.bin");
+
+	// warm start - snapshot is up to date with csv files
+	{
+		auto& phase = this->load_report_.phase(LoadPhaseType::SNAPSHOT_LOAD);
+		auto timer = ScopedTimer(phase, this->arena_);
+
+		try {
+			if (this->load_from_snapshot_(snapshot_path)) {
+				std::error_code error;
+				phase.bytes = std::filesystem::file_size(snapshot_path, error);
+				phase.rows = this->population_store_.unit_count();
+				return;
+			}
+		}
+		catch (std::runtime_error& e) {
+			phase.failed = true;
+
+			// broken snapshot is only a cache miss - csv files are loaded and snapshot is written again.
+			// Snapshot is rejected before any unit is built, so csv loading starts from empty holder.
+			std::cerr << "Snapshot nebol načítaný: " << e.what() << std::endl;
+		}
+	}
+
+	// cold start - parse csv files and store result for next start
+	this->load_from_csv_();
+
+	auto& phase = this->load_report_.phase(LoadPhaseType::SNAPSHOT_SAVE);
+	try {
+		auto timer = ScopedTimer(phase, this->arena_);
+
+		this->save_snapshot(snapshot_path);
+
+		std::error_code error;
+		phase.bytes = std::filesystem::file_size(snapshot_path, error);
+		phase.rows = this->population_store_.unit_count();
+	}
+	catch (std::runtime_error& e) {
+		// snapshot is only a cache - if we can't write it, next start will just parse csv files again
+		phase.failed = true;
+	}
+}
+
+std::string DataHandling::DataHolder::data_path_(const std::string& file_name) const {
+	return (std::filesystem::path(this->data_directory_) / file_name).string();
+}
+
+void DataHandling::DataHolder::discover_years_(Containers::LinkedList<int>& years) const {
+	for (auto& entry : std::filesystem::directory_iterator(this->data_directory_)) {
+		if (not entry.is_regular_file() || entry.path().extension() != ".csv") {
+			continue;
+		}
+
+		// only files named by year are population files
+		auto stem = entry.path().stem().string();
+		if (stem.empty() || stem.find_first_not_of("0123456789") != std::string::npos) {
+			continue;
+		}
+
+		// stem too large for year is not population file
+		int year = 0;
+		auto result = std::from_chars(stem.data(), stem.data() + stem.size(), year);
+		if (result.ec != std::errc() || result.ptr != stem.data() + stem.size()) {
+			continue;
+		}
+
+		// file is loaded as <year>.csv, so other spellings of same year (02020.csv next to 2020.csv) are skipped
+		if (std::to_string(year) != stem) {
+			continue;
+		}
+
+		years.push_back(year);
+	}
+
+	Algorithms::quick_sort(years.begin(), years.end(), [](const int left, const int right) {
+		return left - right;
+	});
+}
+
+DataHandling::LandUnitData* DataHandling::DataHolder::create_unit_(std::string_view name, std::string_view identifier, const int unit_level) {
+	return &this->land_units_list_.push_back(
+		{this->string_pool_.intern(name), this->string_pool_.intern(identifier), unit_level, &this->population_store_, this->population_store_.register_unit()}
+	);
+}
+
+void DataHandling::DataHolder::register_unit_(LandUnitData* land_unit, const bool is_town) {
+	// towns have their own table - there can be more towns with same name
+	if (is_town) {
+		land_unit->mark_as_town();
+		this->towns_table_.find_or_insert(land_unit->get_name(), this->data_allocator_).push_back(land_unit);
+		return;
+	}
 
-	switch (category) {
-		case 0: {
-			node->get_item()->male_population_at(year_index) +=  population;
+	// insert land unit into correct table
+	switch (land_unit->get_unit_level()) {
+		case 1:
+			this->geographic_areas_table_.insert(land_unit->get_name(), land_unit);
 			break;
-		};
-		case 1: {
-			node->get_item()->female_population_at(year_index) +=  population;
+		case 2:
+			this->republics_table_.insert(land_unit->get_name(), land_unit);
 			break;
-		};
-		default: {
-			throw std::runtime_error("Category does not exist");
-		}
+		case 3:
+			this->regions_table_.insert(land_unit->get_name(), land_unit);
+			break;
+		default:
+			throw std::runtime_error("This is not supposed to happend");
+	}
+}
+
+void DataHandling::DataHolder::freeze_hierarchy_() {
+	this->frozen_hierarchy_ = FrozenHierarchyType(&this->root_node_, this->data_allocator_);
+
+	auto hierarchy = this->root_node_.preorder();
+	for (auto node = hierarchy.begin(); node != hierarchy.end(); ++node) {
+		node.get_node()->build_child_index(unit_name_, unit_identifier_);
+	}
+}
+
+void DataHandling::DataHolder::index_unit_node_(LandNodeType* node) {
+	// key is view into interned identifier, so it stays valid after csv files are unmapped
+	this->identifier_index_.insert(restrict_identifier_(node->get_item()->get_identifier()), node);
+}
+
+DataHandling::DataHolder::LandNodeType* DataHandling::DataHolder::find_node_by_code(std::string_view code) const {
+	// full code has angle brackets
+	if (code.size() >= 2 && code.front() == '<' && code.back() == '>') {
+		code = restrict_identifier_(code);
 	}
 
+	auto node = this->identifier_index_.find(code);
+	return (node == nullptr) ? nullptr : *node;
+}
+
+DataHandling::LandUnitData* DataHandling::DataHolder::find_unit_by_code(std::string_view code) const {
+	auto node = this->find_node_by_code(code);
+	return (node == nullptr) ? nullptr : node->get_item();
+}
+
+bool DataHandling::DataHolder::move_to_children_by_name(LandNodeType::Iterator& iterator, std::string_view name) {
+	return iterator.move_to_children_by_key(CHILD_BY_NAME_, name, unit_name_);
+}
+
+bool DataHandling::DataHolder::move_to_children_by_id(LandNodeType::Iterator& iterator, std::string_view identifier) {
+	return iterator.move_to_children_by_key(CHILD_BY_IDENTIFIER_, identifier, unit_identifier_);
 }
 
-DataHandling::DataHolder::DataHolder() {
+void DataHandling::DataHolder::load_from_csv_() {
 
 	/*
 	Step 1: load data starting from higher units to lower
 	Step 2: for each unit, create node in tree
-	Step 3: store this node in temporary table which maps shortened id => node
-	Step 4: after everything is loaded, load populations
-	Step 5: for each population change, also add population into upper units
+	Step 3: store this node in identifier index which maps shortened id => node (it is kept after loading)
+	Step 4: after everything is loaded, load populations from every <year>.csv (each file on its own thread, rows are joined with towns by id)
+	Step 5: populations are stored only in towns - add them into upper units in one pass over the tree
 	*/
 
 	// STEP 1 (ONE)
-	// initialize temporary table
-	Containers::LinkedTable<std::string, LandNodeType*> id_to_node_mapper;
-
-	// add austria into this temporary table
-	id_to_node_mapper.insert("AT", &this->root_node_);
+	// add austria into identifier index
+	this->index_unit_node_(&this->root_node_);
 
 	// load upper areas
 	{
-		// open stream
-		auto stream = std::ifstream(R"(../../data/uzemie.csv)");
-		std::string line;
+		auto& phase = this->load_report_.phase(LoadPhaseType::HIERARCHY);
+		auto timer = ScopedTimer(phase, this->arena_);
 
-		if (not stream.is_open()) {
-			throw std::runtime_error("Could not open file");
-		};
+		// map file
+		auto file = MappedFile(this->data_path_("uzemie.csv"));
+		phase.bytes = file.size();
 
 		// cycle over every line in file
-		while (std::getline(stream, line)) {
-			std::string name, full_id, restricted_id;
+		for (auto line : file.lines()) {
+			std::string_view name, full_id, restricted_id;
+			++phase.rows;
 
 			// read data
 			DataHandling::CsvLineReader(line)
-				.handleField([&name](const std::string& field ) {
+				.handleField([&name](std::string_view field ) {
 					name = field;
 				})
-				->handleField([&full_id, &restricted_id](const std::string& field ) {
+				->handleField([&full_id, &restricted_id](std::string_view field ) {
 					full_id = field;
-					restricted_id = field.substr(1, field.size() - 2);
+					restricted_id = restrict_identifier_(field);
 				});
 
 			// create parent's restricted id - this is achievable by the fact that parent id is always shorter by one digit from child
-			std::string restricted_parent_id = restricted_id.substr(0, restricted_id.size() - 1);
+			std::string_view restricted_parent_id = restricted_id.substr(0, restricted_id.size() - 1);
 
 			// get parent node
-			auto parent_node_ptr = id_to_node_mapper.at(restricted_parent_id);
+			auto parent_node_ptr = this->identifier_index_.at(restricted_parent_id);
+			++phase.lookups;
 
 			// create new land unit
-			auto new_land_unit_ptr = &this->land_units_list_.push_back(
-				{name, full_id, parent_node_ptr->get_item()->get_unit_level() + 1}
-			);
+			auto new_land_unit_ptr = this->create_unit_(name, full_id, parent_node_ptr->get_item()->get_unit_level() + 1);
 
 			// create new tree node
 			auto new_land_node_ptr =  parent_node_ptr->push_back_children(new_land_unit_ptr);
 
 			// insert new land unit into correct table
-			switch (new_land_unit_ptr->get_unit_level()) {
-				case 1:
-					this->geographic_areas_table_.insert(name, new_land_unit_ptr);
-					break;
-				case 2:
-					this->republics_table_.insert(name, new_land_unit_ptr);
-					break;
-				case 3:
-					this->regions_table_.insert(name, new_land_unit_ptr);
-					break;
-				default:
-					throw std::runtime_error("This is not supposed to happend");
-			}
+			this->register_unit_(new_land_unit_ptr, false);
 
-			// insert land node into mapper
-			id_to_node_mapper.insert(restricted_id, new_land_node_ptr);
+			// insert land node into identifier index
+			this->index_unit_node_(new_land_node_ptr);
 		}
-		stream.close();
 	};
 
 	// load town categorization
 	{
-		// open stream
-		auto stream = std::ifstream(R"(../../data/obce.csv)");
-		std::string line;
-		if (not stream.is_open()) {
-			throw std::runtime_error("Could not open file");
+		auto& phase = this->load_report_.phase(LoadPhaseType::TOWNS);
+		auto timer = ScopedTimer(phase, this->arena_);
+
+		// map file
+		auto file = MappedFile(this->data_path_("obce.csv"));
+		phase.bytes = file.size();
+
+		// towns of one district follow each other in file - they are collected and attached to district at once
+		LandNodeType* group_parent_ptr = nullptr;
+		Containers::ArrayList<LandUnitData*> group_units;
+
+		auto attach_group = [this, &group_parent_ptr, &group_units]() {
+			if (group_units.empty()) {
+				return;
+			}
+
+			// create tree nodes - new nodes are last children of parent, in same order as units
+			auto new_land_node_ptr = group_parent_ptr->push_back_children(group_units.begin(), group_units.end());
+
+			for (; new_land_node_ptr != nullptr; new_land_node_ptr = new_land_node_ptr->get_sibling()) {
+				auto new_land_unit_ptr = new_land_node_ptr->get_item();
+
+				// insert unit into table
+				this->register_unit_(new_land_unit_ptr, true);
+
+				// insert land node into identifier index
+				this->index_unit_node_(new_land_node_ptr);
+			}
+
+			group_units.clear();
 		};
 
 		// cycle over every line in file
-		while (std::getline(stream, line)) {
-			std::string name, full_id, restricted_id, restricted_parent_id;
+		for (auto line : file.lines()) {
+			std::string_view name, full_id, restricted_parent_id;
+			++phase.rows;
 
 			// read data
 			DataHandling::CsvLineReader(line)
-				.handleField([&name](const std::string& field ) {
+				.handleField([&name](std::string_view field ) {
 					name = field;
 				})
-				->handleField([&full_id, &restricted_id](const std::string& field ) {
+				->handleField([&full_id](std::string_view field ) {
 					full_id = field;
-					restricted_id = field.substr(1, field.size() - 2);
 				})
-				->handleField([&restricted_parent_id](const std::string& field ) {
+				->handleField([&restricted_parent_id](std::string_view field ) {
 					restricted_parent_id = field.substr(0, field.size() - 1);
 				});
 
 			// get parent node
-			auto parent_node_ptr = id_to_node_mapper.at(restricted_parent_id);
-
-			// create new land unit
-			auto new_land_unit_ptr = &this->land_units_list_.push_back(
-				{name, full_id, parent_node_ptr->get_item()->get_unit_level() + 1}
-			);
-
-			// create new tree node
-			auto new_land_node_ptr =  parent_node_ptr->push_back_children(new_land_unit_ptr);
-
-			// insert unit into table
-			auto list = Containers::LinkedList<LandUnitData*>();
-			list.push_back(new_land_unit_ptr);
+			auto parent_node_ptr = this->identifier_index_.at(restricted_parent_id);
+			++phase.lookups;
 
-			if (this->towns_table_.try_insert(name, list) == nullptr) {
-				this->towns_table_.at(name).push_back(new_land_unit_ptr);
+			// town of other district? Previous district is complete
+			if (parent_node_ptr != group_parent_ptr) {
+				attach_group();
+				group_parent_ptr = parent_node_ptr;
 			}
 
-			// insert land node into mapper
-			id_to_node_mapper.insert(restricted_id, new_land_node_ptr);
+			// create new land unit
+			group_units.push_back(this->create_unit_(name, full_id, parent_node_ptr->get_item()->get_unit_level() + 1));
 		};
+
+		attach_group();
+
+		// hierarchy is complete
+		this->freeze_hierarchy_();
 	};
 
 
 	// load town population data
 	{
-		std::ifstream streams[] = {
-			std::ifstream(R"(../../data/2020.csv)"),
-			std::ifstream(R"(../../data/2021.csv)"),
-			std::ifstream(R"(../../data/2022.csv)"),
-			std::ifstream(R"(../../data/2023.csv)"),
-			std::ifstream(R"(../../data/2024.csv)"),
-		};
+		auto& phase = this->load_report_.phase(LoadPhaseType::POPULATIONS);
+		auto timer = ScopedTimer(phase, this->arena_);
 
-		for (auto& sideStream : streams) {
-			if (!sideStream.is_open()) {
-				throw std::runtime_error("Error opening file stream.");
-			};
-		};
+		Containers::LinkedList<int> years;
+		this->discover_years_(years);
 
-		std::string lines[5];
-		while (getline(streams[0], lines[0])) {
-			for (size_t index = 1; index < 5; index++) {
-				getline(streams[index], lines[index]);
-			}
-
-
-			// find node we will be filling with data
-			LandNodeType* current_land_node = nullptr;
-			bool is_special_case = false;
-
-			// we will find this by reading part of first line
-			DataHandling::CsvLineReader(lines[0])
-				.skipField()
-				->handleField([&current_land_node, &id_to_node_mapper, &is_special_case](const std::string& field ) {
-					auto restricted_town_id = field.substr(1, field.size() - 2);
-
-					try {
-						current_land_node = id_to_node_mapper.at(restricted_town_id);
-					}
-					catch (std::out_of_range& e) {
-						// only one item will trigger this - "Nicht klassifizierbar"
-						// i don't know what job it has, but it is not used anwyhere, soo...
-						is_special_case = true;
-					}
-			});
+		if (years.empty()) {
+			throw std::runtime_error("No population file (<year>.csv) in " + this->data_directory_);
+		}
 
-			// is special case? Skip it
-			if (is_special_case) {
-				is_special_case = false;
-				continue;;
-			}
+		// only years with file get their column
+		YearIndex year_index;
+		for (auto year : years) {
+			year_index.add(year);
+		}
+		this->population_store_.allocate(year_index);
 
-			// iterate over all lines
-			for (size_t index = 0; index < 5; ++index) {
-				DataHandling::CsvLineReader(lines[index])
-					.skipField()->skipField() // skip first two fields
-					->handleField([&index, &current_land_node](const std::string& field ) {
-						auto population = std::stoi(field);
+		// load every year file on its own thread
+		Containers::LinkedList<YearFile_> year_files;
+		for (auto year : years) {
+			auto& year_file = year_files.emplace_back(year_index.index_of(year), this->data_path_(std::to_string(year) + ".csv"));
+			phase.bytes += year_file.file.size();
+		}
 
-						add_population_(current_land_node, 0, index, population );
-					})
-					->skipField()
-					->handleField([&index, &current_land_node](const std::string& field ) {
-						auto population = std::stoi(field);
+		for (auto& year_file : year_files) {
+			year_file.loading_task = std::async(std::launch::async, [&year_file, this]() {
+				return load_population_file_(year_file.file, year_file.year_index, this->identifier_index_);
+			});
+		}
 
-						add_population_(current_land_node, 1, index, population );
-					});
-			};
+		// wait for all threads - get() also rethrows anything that failed in them
+		for (auto& year_file : year_files) {
+			auto row_count = year_file.loading_task.get();
+			phase.rows += row_count;
+			phase.lookups += row_count;
+		}
+	};
 
-		};
+	// add populations of towns into all upper units
+	{
+		auto& phase = this->load_report_.phase(LoadPhaseType::ROLLUP);
+		auto timer = ScopedTimer(phase, this->arena_);
 
-		for (auto& stream : streams) {
-			stream.close();
-		};
+		aggregate_population_(this->frozen_hierarchy_);
+		phase.rows = this->population_store_.unit_count();
 	};
-
 }
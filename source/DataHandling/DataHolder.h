@@ -2,12 +2,20 @@
 #define DATAHOLDER_H
 
 #include <string>
+#include <string_view>
 
+#include "../Containers/ArenaAllocator.h"
+#include "../Containers/FlatTable.h"
+#include "../Containers/FrozenTree.h"
+#include "../Containers/LinkedList.h"
 #include "../Containers/NodeBasedTree.h"
 #include "../Containers/LinkedTable.h"
 
 #include "LandUnitData.h"
-#include "../Containers/NodeBasedTree.h"
+#include "LoadReport.h"
+#include "PopulationStore.h"
+#include "StringPool.h"
+#include "YearIndex.h"
 
 
 namespace DataHandling {
@@ -42,31 +50,196 @@ namespace DataHandling {
 
 	class DataHolder {
 	public:
+		// allocator used by every container of dataset
+		template<typename ItemType>
+		using DataAllocatorType = Containers::ArenaAllocator<ItemType>;
+
+		// hash table behind every unit table - Containers::FlatTable has same interface and can be used instead
+		// (compare both with table_benchmark before switching - FlatTable moves its values when it grows, LinkedTable keeps them in place)
+		template<typename KeyType, typename ValueType, typename AllocatorType>
+		using HashTableType = Containers::LinkedTable<KeyType, ValueType, AllocatorType>;
+
+		// table which maps names of units onto values - keys are interned names
+		template<typename ValueType>
+		using UnitTableType = HashTableType<std::string_view, ValueType, DataAllocatorType<std::pair<const std::string_view, ValueType>>>;
+
+		// list of towns sharing one name
+		using TownListType = Containers::LinkedList<LandUnitData*, DataAllocatorType<LandUnitData*>>;
+
+		// node type
+		using LandNodeType = Containers::TreeNode<LandUnitData*, DataAllocatorType<LandUnitData*>>;
 
+		// table which maps restricted identifiers (AT111 for <AT111>) onto nodes of units
+		using IdentifierIndexType = UnitTableType<LandNodeType*>;
+
+		// hierarchy copied into one array in pre-order
+		using FrozenHierarchyType = Containers::FrozenTree<LandUnitData*, DataAllocatorType<LandUnitData*>>;
+
+	private:
+		// whole dataset is allocated from this arena - it is declared first, so it is released last (at once)
+		Containers::Arena arena_;
+		DataAllocatorType<char> data_allocator_ = DataAllocatorType<char>(arena_);
+
+		// names and identifiers of every unit - tables and units only hold views into it
+		StringPool string_pool_ = StringPool(arena_);
+
+	public:
 		// table for each level of land unit
-		Containers::LinkedTable<std::string, LandUnitData*> geographic_areas_table_;
-		Containers::LinkedTable<std::string, LandUnitData*> republics_table_;
-		Containers::LinkedTable<std::string, LandUnitData*> regions_table_;
-		Containers::LinkedTable<std::string, Containers::LinkedList<LandUnitData*>> towns_table_;
+		UnitTableType<LandUnitData*> geographic_areas_table_ = UnitTableType<LandUnitData*>(data_allocator_);
+		UnitTableType<LandUnitData*> republics_table_ = UnitTableType<LandUnitData*>(data_allocator_);
+		UnitTableType<LandUnitData*> regions_table_ = UnitTableType<LandUnitData*>(data_allocator_);
+		UnitTableType<TownListType> towns_table_ = UnitTableType<TownListType>(data_allocator_);
+
+		// populations of every single land unit in every loaded year
+		PopulationStore population_store_;
 
 		// sequence of every single land unit
-		Containers::LinkedList<LandUnitData> land_units_list_;
+		Containers::LinkedList<LandUnitData, DataAllocatorType<LandUnitData>> land_units_list_ = Containers::LinkedList<LandUnitData, DataAllocatorType<LandUnitData>>(data_allocator_);
 
 		// highest territorial unit - great austrian repulic itself.
-		DataHandling::LandUnitData austria_unit_ = {"Rakúsko", "<AT>", 0};
-
-		// node type
-		using LandNodeType = Containers::TreeNode<LandUnitData*>;
+		DataHandling::LandUnitData austria_unit_ = {
+			string_pool_.intern("Rakúsko"), string_pool_.intern("<AT>"), 0, &population_store_, population_store_.register_unit()
+		};
 
 		// root of hierarchy
-		LandNodeType root_node_ = LandNodeType(&austria_unit_);
+		LandNodeType root_node_ = LandNodeType(&austria_unit_, data_allocator_);
+
+		// hierarchy doesn't change after loading - scans of whole hierarchy or subtrees go through its frozen copy
+		FrozenHierarchyType frozen_hierarchy_ = FrozenHierarchyType(data_allocator_);
+
+	private:
+		// node of every unit under its restricted identifier - built while loading and kept for lookups by code
+		IdentifierIndexType identifier_index_ = IdentifierIndexType(data_allocator_);
+
+		// directory with all csv files (and snapshot)
+		std::string data_directory_;
+
+		// timings and counters of loading
+		LoadReport load_report_;
+
+		/**
+		 * Returns path to file inside data directory
+		 */
+		std::string data_path_(const std::string& file_name) const;
+
+		/**
+		 * Finds every population file (named <year>.csv) in data directory
+		 *
+		 * \param years : list which will be filled with found years, in ascending order
+		 */
+		void discover_years_(Containers::LinkedList<int>& years) const;
+
+		/**
+		 * Creates new land unit with its own population slot
+		 */
+		LandUnitData* create_unit_(std::string_view name, std::string_view identifier, int unit_level);
+
+		/**
+		 * Inserts land unit into table of its level (or into towns table)
+		 */
+		void register_unit_(LandUnitData* land_unit, bool is_town);
+
+		/**
+		 * Inserts node into identifier index
+		 */
+		void index_unit_node_(LandNodeType* node);
+
+		/**
+		 * Copies finished hierarchy into frozen hierarchy and builds child index of every node - called once, when every node is loaded
+		 */
+		void freeze_hierarchy_();
+
+		/**
+		 * Parses csv files and builds hierarchy, tables and populations from them
+		 */
+		void load_from_csv_();
+
+		/**
+		 * Lists every file from which snapshot is created - snapshot is stale if any of them changes
+		 */
+		void snapshot_sources_(Containers::LinkedList<std::string>& sources) const;
+
+		/**
+		 * Builds hierarchy, tables and populations from binary snapshot
+		 *
+		 * \param path : path to the snapshot
+		 * \return false : snapshot doesn't exist, has different version or is older than csv files - nothing was loaded
+		 * \throw std::runtime_error : snapshot is corrupted - whole snapshot (including uniqueness of keys) is checked before anything is built, so nothing was loaded either
+		 */
+		bool load_from_snapshot_(const std::string& path);
+
 	public:
-		DataHolder();
+		/**
+		 * Loads data from snapshot if it is up to date, otherwise from csv files (and stores new snapshot)
+		 *
+		 * \param data_directory : directory with csv files - populations are loaded from every <year>.csv in it
+		 * \throw std::runtime_error : csv files are missing or broken, or there is no <year>.csv
+		 */
+		explicit DataHolder(const std::string& data_directory = R"(../../data)");
+
+		/**
+		 * Writes whole loaded dataset into binary snapshot
+		 *
+		 * \param path : path where snapshot will be written
+		 * \throw std::runtime_error : snapshot could not be written
+		 */
+		void save_snapshot(const std::string& path);
+
+		/**
+		 * Returns years for which populations were loaded
+		 */
+		const YearIndex& get_population_years() const {
+			return this->population_store_.years();
+		}
+
+		/**
+		 * Returns hierarchy stored in pre-order - root is at index 0
+		 */
+		const FrozenHierarchyType& get_frozen_hierarchy() const {
+			return this->frozen_hierarchy_;
+		}
+
+		/**
+		 * Returns timings and counters of every block of loading
+		 */
+		const LoadReport& get_load_report() const {
+			return this->load_report_;
+		}
 
 		auto get_tree_iterator() {
 			return this->root_node_.begin();
 		}
 
+		/**
+		 * Finds node of unit by its code in constant time
+		 *
+		 * \param code : full (<AT111>, <10801>) or restricted (AT111, 10801) identifier
+		 * \return nullptr : no unit has this code
+		 */
+		LandNodeType* find_node_by_code(std::string_view code) const;
+
+		/**
+		 * Finds unit by its code in constant time
+		 *
+		 * \param code : full (<AT111>, <10801>) or restricted (AT111, 10801) identifier
+		 * \return nullptr : no unit has this code
+		 */
+		LandUnitData* find_unit_by_code(std::string_view code) const;
+
+		/**
+		 * Moves iterator into children with given name (if there are more of them, any one is chosen)
+		 *
+		 * \return false : current unit has no children with this name - iterator stays where it was
+		 */
+		static bool move_to_children_by_name(LandNodeType::Iterator& iterator, std::string_view name);
+
+		/**
+		 * Moves iterator into children with given identifier (like <AT111>)
+		 *
+		 * \return false : current unit has no children with this identifier - iterator stays where it was
+		 */
+		static bool move_to_children_by_id(LandNodeType::Iterator& iterator, std::string_view identifier);
+
 	};
 }
 
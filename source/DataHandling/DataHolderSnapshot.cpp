@@ -0,0 +1,325 @@
+#include <cstdint>
+#include <filesystem>
+
+#include "../Containers/ArrayList.h"
+
+#include "DataHolder.h"
+#include "MappedFile.h"
+#include "SnapshotIO.h"
+
+/*
+Snapshot layout (all values in native byte order):
+	header:		magic, version, number of population years, then every population year in ascending order
+	sources:	number of source files, then size and modification time of each of them (uzemie, obce, year files in ascending order)
+	units:		number of units (austria included), then for every unit except austria: parent index, unit level, town flag, name, identifier
+	population:	for every year - male population column, then female population column (indexed by population slots)
+
+Units are stored in the same order in which csv loading creates them, so every parent is stored before its children.
+Replaying them in this order rebuilds identical tree and tables, and gives every unit the same population slot.
+*/
+
+const uint32_t SNAPSHOT_MAGIC_ = 0x50414E53;
+const uint32_t SNAPSHOT_VERSION_ = 4;
+
+// stored unit with empty name and identifier - parent index, unit level, town flag and lengths of both strings
+const size_t SNAPSHOT_MIN_UNIT_SIZE_ = sizeof(uint32_t) + sizeof(int32_t) + sizeof(uint8_t) + 2 * sizeof(uint32_t);
+
+/**
+* Identifies one version of source file
+*/
+struct SourceFingerprint_ {
+	uint64_t size = 0;
+	int64_t modification_time = 0;
+
+	bool operator==(const SourceFingerprint_& other) const {
+		return this->size == other.size && this->modification_time == other.modification_time;
+	}
+};
+
+/**
+* Creates fingerprint of source file. Missing file has empty fingerprint.
+*/
+SourceFingerprint_ fingerprint_source_(const std::string& path) {
+	std::error_code error;
+	SourceFingerprint_ fingerprint;
+
+	fingerprint.size = std::filesystem::file_size(path, error);
+	if (error) {
+		return {};
+	}
+
+	fingerprint.modification_time = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+	if (error) {
+		return {};
+	}
+
+	return fingerprint;
+}
+
+// defined in DataHolder.cpp - index and tables use identifiers without angle brackets
+std::string_view restrict_identifier_(std::string_view identifier);
+
+/**
+* One unit read from snapshot - units are built only after whole snapshot is read
+*/
+struct SnapshotUnit_ {
+	uint32_t parent_index = 0;
+	int unit_level = 0;
+	bool is_town = false;
+
+	// views into mapped snapshot
+	std::string_view name;
+	std::string_view identifier;
+};
+
+/**
+* Stores index of parent of every unit under node
+*/
+void collect_parent_indexes_(
+	DataHandling::DataHolder::LandNodeType* node,
+	Containers::LinkedTable<const DataHandling::LandUnitData*, uint32_t>& unit_indexes,
+	Containers::ArrayList<uint32_t>& parent_indexes
+) {
+	auto node_index = unit_indexes.at(node->get_item());
+
+	for (auto child = node->get_children(); child != nullptr; child = child->get_sibling()) {
+		parent_indexes[unit_indexes.at(child->get_item())] = node_index;
+
+		collect_parent_indexes_(child, unit_indexes, parent_indexes);
+	}
+}
+
+
+void DataHandling::DataHolder::snapshot_sources_(Containers::LinkedList<std::string>& sources) const {
+	sources.push_back(this->data_path_("uzemie.csv"));
+	sources.push_back(this->data_path_("obce.csv"));
+
+	Containers::LinkedList<int> years;
+	this->discover_years_(years);
+
+	for (auto year : years) {
+		sources.push_back(this->data_path_(std::to_string(year) + ".csv"));
+	}
+}
+
+
+void DataHandling::DataHolder::save_snapshot(const std::string& path) {
+	// give every unit its index - austria is first, other units follow in order they were loaded
+	Containers::LinkedTable<const LandUnitData*, uint32_t> unit_indexes;
+	uint32_t unit_count = 0;
+
+	unit_indexes.insert(&this->austria_unit_, unit_count++);
+	for (auto& land_unit : this->land_units_list_) {
+		unit_indexes.insert(&land_unit, unit_count++);
+	}
+
+	Containers::ArrayList<uint32_t> parent_indexes(unit_count, 0);
+	collect_parent_indexes_(&this->root_node_, unit_indexes, parent_indexes);
+
+	// town is every unit from towns table, wherever it was loaded
+	Containers::ArrayList<uint8_t> town_flags(unit_count, 0);
+	for (auto& towns : this->towns_table_) {
+		for (auto town : towns.second) {
+			town_flags[unit_indexes.at(town)] = 1;
+		}
+	}
+
+	Containers::LinkedList<std::string> sources;
+	this->snapshot_sources_(sources);
+
+	const auto& years = this->population_store_.years();
+
+	auto writer = SnapshotWriter(path);
+
+	// header
+	writer
+		.write(SNAPSHOT_MAGIC_)
+		.write(SNAPSHOT_VERSION_)
+		.write(static_cast<uint32_t>(years.size()));
+
+	for (size_t year_index = 0; year_index < years.size(); ++year_index) {
+		writer.write(static_cast<int32_t>(years.year_at(year_index)));
+	}
+
+	// sources
+	writer.write(static_cast<uint32_t>(sources.size()));
+	for (auto& source : sources) {
+		auto fingerprint = fingerprint_source_(source);
+		writer.write(fingerprint.size).write(fingerprint.modification_time);
+	}
+
+	// units
+	writer.write(unit_count);
+
+	uint32_t unit_index = 1;
+	for (auto& land_unit : this->land_units_list_) {
+		writer
+			.write(parent_indexes[unit_index])
+			.write(static_cast<int32_t>(land_unit.get_unit_level()))
+			.write(town_flags[unit_index])
+			.write_string(land_unit.get_name())
+			.write_string(land_unit.get_identifier());
+
+		++unit_index;
+	}
+
+	// population - slots were given to units in the same order in which they are stored
+	const auto slot_count = this->population_store_.unit_count();
+
+	for (size_t year_index = 0; year_index < years.size(); ++year_index) {
+		for (size_t slot = 0; slot < slot_count; ++slot) {
+			writer.write(static_cast<int32_t>(this->population_store_.male_population_at(slot, year_index)));
+		}
+		for (size_t slot = 0; slot < slot_count; ++slot) {
+			writer.write(static_cast<int32_t>(this->population_store_.female_population_at(slot, year_index)));
+		}
+	}
+
+	writer.finish();
+}
+
+
+bool DataHandling::DataHolder::load_from_snapshot_(const std::string& path) {
+	std::error_code error;
+	if (not std::filesystem::exists(path, error)) {
+		return false;
+	}
+
+	auto file = MappedFile(path);
+	auto reader = SnapshotReader(file.view());
+
+	Containers::LinkedList<std::string> sources;
+	this->snapshot_sources_(sources);
+
+	YearIndex years;
+
+	// check header and sources - any mismatch means snapshot is just stale, not broken
+	try {
+		if (reader.read<uint32_t>() != SNAPSHOT_MAGIC_ || reader.read<uint32_t>() != SNAPSHOT_VERSION_) {
+			return false;
+		}
+
+		auto year_count = reader.read<uint32_t>();
+		// snapshot is written only when some population file was loaded
+		if (year_count == 0) {
+			return false;
+		}
+
+		for (uint32_t index = 0; index < year_count; ++index) {
+			auto year = reader.read<int32_t>();
+			if (not years.empty() && year <= years.last_year()) {
+				return false;
+			}
+
+			years.add(year);
+		}
+
+		if (reader.read<uint32_t>() != sources.size()) {
+			return false;
+		}
+
+		for (auto& source : sources) {
+			SourceFingerprint_ stored;
+			stored.size = reader.read<uint64_t>();
+			stored.modification_time = reader.read<int64_t>();
+
+			if (not (stored == fingerprint_source_(source))) {
+				return false;
+			}
+		}
+	}
+	catch (std::runtime_error& e) {
+		return false;
+	}
+
+	// units - whole snapshot is read and checked first, so corrupted snapshot doesn't leave half of units loaded
+	auto unit_count = reader.read<uint32_t>();
+	if (unit_count == 0 || reader.remaining() / SNAPSHOT_MIN_UNIT_SIZE_ < unit_count - 1) {
+		throw std::runtime_error("Snapshot is corrupted");
+	}
+
+	Containers::ArrayList<SnapshotUnit_> units;
+	units.reserve(unit_count);
+	units.push_back({0, 0, false, {}, {}});
+
+	// keys which tables and identifier index will get - they have to be unique, otherwise building would fail half way
+	Containers::LinkedTable<std::string_view, uint32_t> used_identifiers;
+	Containers::LinkedTable<std::string_view, uint32_t> used_area_names;
+	Containers::LinkedTable<std::string_view, uint32_t> used_republic_names;
+	Containers::LinkedTable<std::string_view, uint32_t> used_region_names;
+	Containers::LinkedTable<std::string_view, uint32_t>* used_names[] = {&used_area_names, &used_republic_names, &used_region_names};
+
+	used_identifiers.insert(restrict_identifier_(this->austria_unit_.get_identifier()), 0);
+
+	for (uint32_t index = 1; index < unit_count; ++index) {
+		SnapshotUnit_ unit;
+		unit.parent_index = reader.read<uint32_t>();
+		unit.unit_level = reader.read<int32_t>();
+		unit.is_town = reader.read<uint8_t>() != 0;
+		unit.name = reader.read_string();
+		unit.identifier = reader.read_string();
+
+		// parents are always stored before their children
+		if (unit.parent_index >= index) {
+			throw std::runtime_error("Snapshot is corrupted");
+		}
+
+		// unit is always below its parent and only towns can be deeper than regions
+		if (unit.unit_level <= units[unit.parent_index].unit_level || (not unit.is_town && unit.unit_level > 3)) {
+			throw std::runtime_error("Snapshot is corrupted");
+		}
+
+		// identifier has angle brackets around restricted identifier
+		if (unit.identifier.size() < 2 || used_identifiers.try_insert(restrict_identifier_(unit.identifier), index) == nullptr) {
+			throw std::runtime_error("Snapshot is corrupted");
+		}
+
+		// towns have list of units under every name, other units must have unique names within their level
+		if (not unit.is_town && used_names[unit.unit_level - 1]->try_insert(unit.name, index) == nullptr) {
+			throw std::runtime_error("Snapshot is corrupted");
+		}
+
+		units.push_back(unit);
+	}
+
+	// population - male and female column of every year, nothing may follow them
+	if (reader.remaining() != years.size() * 2 * unit_count * sizeof(int32_t)) {
+		throw std::runtime_error("Snapshot is truncated");
+	}
+
+	// snapshot is valid - nothing below can fail, so tables and hierarchy are never left half built
+	Containers::ArrayList<LandNodeType*> nodes(unit_count, nullptr);
+
+	nodes[0] = &this->root_node_;
+	this->index_unit_node_(&this->root_node_);
+
+	for (uint32_t index = 1; index < unit_count; ++index) {
+		auto& unit = units[index];
+		auto parent_node_ptr = nodes[unit.parent_index];
+
+		// create new land unit
+		auto new_land_unit_ptr = this->create_unit_(unit.name, unit.identifier, unit.unit_level);
+
+		// create new tree node and insert unit into table
+		nodes[index] = parent_node_ptr->push_back_children(new_land_unit_ptr);
+
+		this->register_unit_(new_land_unit_ptr, unit.is_town);
+		this->index_unit_node_(nodes[index]);
+	}
+
+	// every stored unit got its own slot in the same order in which it was stored
+	this->population_store_.allocate(years);
+
+	for (size_t year_index = 0; year_index < years.size(); ++year_index) {
+		for (uint32_t slot = 0; slot < unit_count; ++slot) {
+			this->population_store_.male_population_at(slot, year_index) = reader.read<int32_t>();
+		}
+		for (uint32_t slot = 0; slot < unit_count; ++slot) {
+			this->population_store_.female_population_at(slot, year_index) = reader.read<int32_t>();
+		}
+	}
+
+	this->freeze_hierarchy_();
+
+	return true;
+}
@@ -1,31 +1,38 @@
 #ifndef LANDUNITDATA_H
 #define LANDUNITDATA_H
 
-#include <string>
+#include <string_view>
 
-namespace DataHandling {
-	const size_t LAND_UNIT_POPULATION_COUNT = 5;
+#include "PopulationStore.h"
 
+namespace DataHandling {
 	class LandUnitData {
-		std::string name_;
-		std::string identifier_;
+		// both strings are interned - they point into string pool of data holder
+		std::string_view name_;
+		std::string_view identifier_;
 		int territory = -1;
 
-		int male_population_count_[LAND_UNIT_POPULATION_COUNT] = {};
-		int female_population_count_[LAND_UNIT_POPULATION_COUNT] = {};
+		// towns are only units with their own populations - upper units get sums of towns
+		bool town_ = false;
+
+		// populations are not stored in unit itself - unit only knows its slot in shared store
+		PopulationStore* population_store_ = nullptr;
+		size_t population_slot_ = 0;
 
 	public:
-		LandUnitData(const std::string &name, const std::string& identifier, const int territory) {
+		LandUnitData(std::string_view name, std::string_view identifier, const int territory, PopulationStore* population_store, const size_t population_slot) {
 			this->name_ = name;
 			this->identifier_ = identifier;
 			this->territory = territory;
+			this->population_store_ = population_store;
+			this->population_slot_ = population_slot;
 		};
 
-		const std::string& get_name() const {
+		std::string_view get_name() const {
 			return this->name_;
 		};
 
-		const std::string& get_identifier() const {
+		std::string_view get_identifier() const {
 			return this->identifier_;
 		};
 
@@ -33,24 +40,42 @@ namespace DataHandling {
 			return this->territory;
 		}
 
+		bool is_town() const {
+			return this->town_;
+		}
+
+		/**
+		 * Marks unit as town - called once, when unit is inserted into towns table
+		 */
+		void mark_as_town() {
+			this->town_ = true;
+		}
+
+		/**
+		 * Returns years for which populations are stored
+		 */
+		const YearIndex& get_population_years() const {
+			return this->population_store_->years();
+		}
+
 		int& male_population_at(const size_t index) {
-			return this->male_population_count_[index];
+			return this->population_store_->male_population_at(this->population_slot_, index);
 		};
 
-		const int& male_population_at(const size_t index) const {
-			return this->male_population_count_[index];
+		int male_population_at(const size_t index) const {
+			return this->population_store_->male_population_at(this->population_slot_, index);
 		}
 
 		int& female_population_at(const size_t index) {
-			return this->female_population_count_[index];
+			return this->population_store_->female_population_at(this->population_slot_, index);
 		}
 
-		const int& female_population_at(const size_t index) const {
-			return this->female_population_count_[index];
+		int female_population_at(const size_t index) const {
+			return this->population_store_->female_population_at(this->population_slot_, index);
 		}
 
 		int get_total_population_at(const size_t index) const {
-			return this->male_population_count_[index] + this->female_population_count_[index];
+			return this->male_population_at(index) + this->female_population_at(index);
 		}
 
 	};
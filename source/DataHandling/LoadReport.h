@@ -0,0 +1,155 @@
+#ifndef LOADREPORT_H
+#define LOADREPORT_H
+
+#include <chrono>
+#include <ostream>
+
+#include "../Containers/ArenaAllocator.h"
+
+namespace DataHandling {
+	/**
+	 * Blocks of data loading which are measured separately
+	 */
+	enum class LoadPhaseType {
+		SNAPSHOT_LOAD,
+		HIERARCHY,
+		TOWNS,
+		POPULATIONS,
+		ROLLUP,
+		SNAPSHOT_SAVE
+	};
+
+	inline constexpr size_t LOAD_PHASE_COUNT = 6;
+
+	/**
+	 * Measurements of one block of loading
+	 */
+	struct LoadPhase {
+		const char* name = "";
+
+		// false when block didn't run during this start (e.g. csv blocks during warm start)
+		bool executed = false;
+
+		// true when block ran, but didn't finish its work (e.g. snapshot could not be written)
+		bool failed = false;
+
+		double milliseconds = 0;
+
+		// lines (or units) processed
+		size_t rows = 0;
+
+		// bytes read from files
+		size_t bytes = 0;
+
+		// allocations from arena of data holder - heap allocations (e.g. population columns, threads) are not counted
+		size_t arena_allocations = 0;
+
+		// lookups into identifier mapper
+		size_t lookups = 0;
+	};
+
+	/**
+	 * Collects measurements of all blocks of one data loading, so they can be printed or dumped as JSON.
+	 */
+	class LoadReport {
+		LoadPhase phases_[LOAD_PHASE_COUNT] = {
+			{"snapshot_load"},
+			{"hierarchy"},
+			{"towns"},
+			{"populations"},
+			{"rollup"},
+			{"snapshot_save"}
+		};
+
+	public:
+		LoadPhase& phase(const LoadPhaseType type) {
+			return this->phases_[static_cast<size_t>(type)];
+		}
+
+		const LoadPhase& phase(const LoadPhaseType type) const {
+			return this->phases_[static_cast<size_t>(type)];
+		}
+
+		/**
+		 * Returns time spent in all executed blocks
+		 */
+		double total_milliseconds() const {
+			double total = 0;
+			for (auto& phase : this->phases_) {
+				total += phase.milliseconds;
+			}
+
+			return total;
+		}
+
+		/**
+		 * Prints table of executed blocks in human readable form
+		 */
+		void print(std::ostream& output) const {
+			for (auto& phase : this->phases_) {
+				if (not phase.executed) {
+					continue;
+				}
+
+				output << phase.name << (phase.failed ? " (zlyhalo)" : "") << " : " << phase.milliseconds << " ms"
+					<< " | rows " << phase.rows
+					<< " | bytes " << phase.bytes
+					<< " | arena allocations " << phase.arena_allocations
+					<< " | lookups " << phase.lookups << std::endl;
+			}
+
+			output << "total : " << this->total_milliseconds() << " ms" << std::endl;
+		}
+
+		/**
+		 * Writes every block as JSON object - blocks which didn't run are included with "executed": false
+		 */
+		void write_json(std::ostream& output) const {
+			output << "{\"total_ms\": " << this->total_milliseconds() << ", \"phases\": [";
+
+			for (size_t index = 0; index < LOAD_PHASE_COUNT; ++index) {
+				auto& phase = this->phases_[index];
+
+				output << (index == 0 ? "" : ", ")
+					<< "{\"name\": \"" << phase.name << "\""
+					<< ", \"executed\": " << (phase.executed ? "true" : "false")
+					<< ", \"failed\": " << (phase.failed ? "true" : "false")
+					<< ", \"ms\": " << phase.milliseconds
+					<< ", \"rows\": " << phase.rows
+					<< ", \"bytes\": " << phase.bytes
+					<< ", \"arena_allocations\": " << phase.arena_allocations
+					<< ", \"lookups\": " << phase.lookups << "}";
+			}
+
+			output << "]}" << std::endl;
+		}
+	};
+
+	/**
+	 * Measures time and arena allocations of its scope and stores them into phase when it is destroyed
+	 */
+	class ScopedTimer {
+		using ClockType = std::chrono::steady_clock;
+
+		LoadPhase& phase_;
+		const Containers::Arena& arena_;
+
+		ClockType::time_point start_;
+		size_t start_allocations_;
+
+	public:
+		ScopedTimer(LoadPhase& phase, const Containers::Arena& arena)
+			: phase_(phase), arena_(arena), start_(ClockType::now()), start_allocations_(arena.allocation_count()) {}
+
+		ScopedTimer(const ScopedTimer& other) = delete;
+		ScopedTimer& operator=(const ScopedTimer& other) = delete;
+
+		~ScopedTimer() {
+			this->phase_.executed = true;
+			this->phase_.milliseconds += std::chrono::duration<double, std::milli>(ClockType::now() - this->start_).count();
+			this->phase_.arena_allocations += this->arena_.allocation_count() - this->start_allocations_;
+		}
+	};
+}
+
+#endif //LOADREPORT_H
@@ -0,0 +1,79 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#if defined(_WIN32)
+	#include <fstream>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+
+#if defined(_WIN32)
+
+DataHandling::MappedFile::MappedFile(const std::string& path) {
+	auto stream = std::ifstream(path, std::ios::binary | std::ios::ate);
+	if (not stream.is_open()) {
+		throw std::runtime_error("Could not open file");
+	}
+
+	this->size_ = static_cast<size_t>(stream.tellg());
+	stream.seekg(0);
+
+	auto buffer = new char[this->size_];
+	stream.read(buffer, static_cast<std::streamsize>(this->size_));
+	this->data_ = buffer;
+}
+
+DataHandling::MappedFile::~MappedFile() {
+	delete[] this->data_;
+}
+
+#else
+
+DataHandling::MappedFile::MappedFile(const std::string& path) {
+	int descriptor = ::open(path.c_str(), O_RDONLY);
+	if (descriptor < 0) {
+		throw std::runtime_error("Could not open file");
+	}
+
+	struct stat file_info = {};
+	if (::fstat(descriptor, &file_info) != 0) {
+		::close(descriptor);
+		throw std::runtime_error("Could not read file size");
+	}
+
+	this->size_ = static_cast<size_t>(file_info.st_size);
+
+	// empty file can't be mapped - it is simply represented by empty view
+	if (this->size_ == 0) {
+		::close(descriptor);
+		return;
+	}
+
+	void* mapping = ::mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+	// mapping stays valid even after descriptor is closed
+	::close(descriptor);
+
+	if (mapping == MAP_FAILED) {
+		throw std::runtime_error("Could not map file");
+	}
+
+	// we will read file once from start to end
+	::madvise(mapping, this->size_, MADV_SEQUENTIAL);
+
+	this->data_ = static_cast<const char*>(mapping);
+	this->is_mapped_ = true;
+}
+
+DataHandling::MappedFile::~MappedFile() {
+	if (this->is_mapped_) {
+		::munmap(const_cast<char*>(this->data_), this->size_);
+	}
+}
+
+#endif
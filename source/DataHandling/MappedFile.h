@@ -0,0 +1,148 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <string_view>
+
+namespace DataHandling {
+	/**
+	 * Represents read-only file whose whole content is mapped into memory.
+	 * Content is accessed through string views, so nothing is copied while parsing it.
+	 *
+	 * NOTE: on platforms without mmap, content is read into single heap buffer instead.
+	 */
+	class MappedFile {
+		const char* data_ = nullptr;
+		size_t size_ = 0;
+		bool is_mapped_ = false;
+
+	public:
+		/**
+		 * Maps file at specified path into memory
+		 *
+		 * \param path : path to the mapped file
+		 * \throw std::runtime_error : file could not be opened or mapped
+		 */
+		explicit MappedFile(const std::string& path);
+
+		MappedFile(const MappedFile& other) = delete;
+		MappedFile& operator=(const MappedFile& other) = delete;
+
+		/**
+		 * Unmaps file (or releases its buffer)
+		 */
+		~MappedFile();
+
+		/**
+		 * Returns view over whole content of file
+		 */
+		std::string_view view() const {
+			return {this->data_, this->size_};
+		}
+
+		/**
+		 * Returns size of file in bytes
+		 */
+		size_t size() const {
+			return this->size_;
+		}
+
+
+		/**
+		 * Represents forward iterator over lines of mapped file. Lines are returned without line terminator.
+		 */
+		class LineIterator {
+			std::string_view rest_;
+			std::string_view line_;
+			bool finished_;
+
+			void read_line_() {
+				if (this->rest_.empty()) {
+					this->finished_ = true;
+					return;
+				}
+
+				auto end = this->rest_.find('\n');
+				if (end == std::string_view::npos) {
+					this->line_ = this->rest_;
+					this->rest_ = {};
+				}
+				else {
+					this->line_ = this->rest_.substr(0, end);
+					this->rest_.remove_prefix(end + 1);
+				}
+
+				// windows line endings
+				if (not this->line_.empty() && this->line_.back() == '\r') {
+					this->line_.remove_suffix(1);
+				}
+			}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+
+			using value_type = std::string_view;
+			using pointer = const std::string_view*;
+			using reference = const std::string_view&;
+			using difference_type = std::ptrdiff_t;
+
+			LineIterator(std::string_view content, bool finished) : rest_(content), finished_(finished) {
+				if (not this->finished_) {
+					this->read_line_();
+				}
+			}
+
+			reference operator*() const {
+				return this->line_;
+			}
+
+			pointer operator->() const {
+				return &this->line_;
+			}
+
+			LineIterator& operator++() {
+				this->read_line_();
+				return *this;
+			}
+
+			bool operator==(const LineIterator& other) const {
+				// every finished iterator is the same end iterator
+				if (this->finished_ || other.finished_) {
+					return this->finished_ == other.finished_;
+				}
+				return this->line_.data() == other.line_.data();
+			}
+
+			bool operator!=(const LineIterator& other) const {
+				return not (*this == other);
+			}
+		};
+
+		/**
+		 * Represents range of lines in mapped file - usable in range based for.
+		 */
+		class LineRange {
+			std::string_view content_;
+
+		public:
+			explicit LineRange(std::string_view content) : content_(content) {}
+
+			LineIterator begin() const {
+				return LineIterator(this->content_, false);
+			}
+
+			LineIterator end() const {
+				return LineIterator({}, true);
+			}
+		};
+
+		/**
+		 * Returns range of lines of this file
+		 */
+		LineRange lines() const {
+			return LineRange(this->view());
+		}
+	};
+}
+
+#endif //MAPPEDFILE_H
@@ -0,0 +1,79 @@
+#ifndef POPULATIONSTORE_H
+#define POPULATIONSTORE_H
+
+#include <memory>
+#include <stdexcept>
+
+#include "YearIndex.h"
+
+namespace DataHandling {
+	/**
+	 * Holds populations of all land units in all years.
+	 * Every year has its own contiguous column, every unit has its own slot (row) in each column.
+	 *
+	 * Units register their slots first, columns are allocated once the number of units and years is known.
+	 */
+	class PopulationStore {
+		YearIndex years_;
+		size_t unit_count_ = 0;
+
+		std::unique_ptr<int[]> male_population_;
+		std::unique_ptr<int[]> female_population_;
+
+	public:
+		PopulationStore() = default;
+
+		PopulationStore(const PopulationStore& other) = delete;
+		PopulationStore& operator=(const PopulationStore& other) = delete;
+
+		/**
+		 * Reserves slot for new unit
+		 *
+		 * \return slot of unit
+		 * \throw std::logic_error : columns were already allocated
+		 */
+		size_t register_unit() {
+			if (this->male_population_ != nullptr) {
+				throw std::logic_error("Cannot register unit after populations were allocated.");
+			}
+
+			return this->unit_count_++;
+		}
+
+		/**
+		 * Allocates columns for specified years. Every population starts at zero.
+		 */
+		void allocate(const YearIndex& years) {
+			this->years_ = years;
+
+			this->male_population_ = std::make_unique<int[]>(this->unit_count_ * this->years_.size());
+			this->female_population_ = std::make_unique<int[]>(this->unit_count_ * this->years_.size());
+		}
+
+		const YearIndex& years() const {
+			return this->years_;
+		}
+
+		size_t unit_count() const {
+			return this->unit_count_;
+		}
+
+		int& male_population_at(const size_t slot, const size_t year_index) {
+			return this->male_population_[year_index * this->unit_count_ + slot];
+		}
+
+		int male_population_at(const size_t slot, const size_t year_index) const {
+			return this->male_population_[year_index * this->unit_count_ + slot];
+		}
+
+		int& female_population_at(const size_t slot, const size_t year_index) {
+			return this->female_population_[year_index * this->unit_count_ + slot];
+		}
+
+		int female_population_at(const size_t slot, const size_t year_index) const {
+			return this->female_population_[year_index * this->unit_count_ + slot];
+		}
+	};
+}
+
+#endif //POPULATIONSTORE_H
@@ -0,0 +1,170 @@
+#ifndef SNAPSHOTIO_H
+#define SNAPSHOTIO_H
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace DataHandling {
+	/**
+	 * Writes plain values and strings into binary file. Values are written in native byte order.
+	 * Everything goes into temporary file first, which replaces target file only when whole snapshot was written,
+	 * so reader never sees half-written snapshot.
+	 */
+	class SnapshotWriter {
+		std::string path_;
+		std::string temporary_path_;
+		std::ofstream stream_;
+
+		bool finished_ = false;
+
+		/**
+		 * \throw std::runtime_error : some of the writes failed
+		 */
+		void check_stream_() const {
+			if (not this->stream_.good()) {
+				throw std::runtime_error("Could not write snapshot");
+			}
+		}
+
+	public:
+		/**
+		 * Opens (and truncates) temporary file next to target file
+		 *
+		 * \throw std::runtime_error : file could not be opened
+		 */
+		explicit SnapshotWriter(const std::string& path) :
+			path_(path), temporary_path_(path + ".tmp"), stream_(temporary_path_, std::ios::binary | std::ios::trunc) {
+			if (not this->stream_.is_open()) {
+				throw std::runtime_error("Could not open snapshot for writing");
+			}
+		}
+
+		SnapshotWriter(const SnapshotWriter& other) = delete;
+		SnapshotWriter& operator=(const SnapshotWriter& other) = delete;
+
+		/**
+		 * Removes temporary file of unfinished snapshot - target file is left untouched
+		 */
+		~SnapshotWriter() {
+			if (not this->finished_) {
+				this->stream_.close();
+
+				std::error_code error;
+				std::filesystem::remove(this->temporary_path_, error);
+			}
+		}
+
+		/**
+		 * \throw std::runtime_error : write failed
+		 */
+		template<typename ValueType>
+		SnapshotWriter& write(const ValueType& value) {
+			static_assert(std::is_trivially_copyable_v<ValueType>, "Only plain values can be written");
+
+			this->stream_.write(reinterpret_cast<const char*>(&value), sizeof(ValueType));
+			this->check_stream_();
+			return *this;
+		}
+
+		/**
+		 * Writes string as its length followed by its bytes
+		 *
+		 * \throw std::runtime_error : write failed
+		 */
+		SnapshotWriter& write_string(std::string_view value) {
+			this->write(static_cast<uint32_t>(value.size()));
+			this->stream_.write(value.data(), static_cast<std::streamsize>(value.size()));
+			this->check_stream_();
+			return *this;
+		}
+
+		/**
+		 * Flushes everything into temporary file and moves it over target file
+		 *
+		 * \throw std::runtime_error : some of the writes failed or file could not be replaced
+		 */
+		void finish() {
+			this->stream_.flush();
+			this->check_stream_();
+
+			this->stream_.close();
+			if (this->stream_.fail()) {
+				throw std::runtime_error("Could not write snapshot");
+			}
+
+			std::error_code error;
+			std::filesystem::rename(this->temporary_path_, this->path_, error);
+			if (error) {
+				throw std::runtime_error("Could not replace snapshot: " + error.message());
+			}
+
+			this->finished_ = true;
+		}
+	};
+
+
+	/**
+	 * Reads values written by SnapshotWriter from memory (usually mapped file).
+	 */
+	class SnapshotReader {
+		std::string_view rest_;
+
+		void require_(size_t size) const {
+			if (this->rest_.size() < size) {
+				throw std::runtime_error("Snapshot is truncated");
+			}
+		}
+
+	public:
+		explicit SnapshotReader(std::string_view content) : rest_(content) {}
+
+		template<typename ValueType>
+		ValueType read() {
+			static_assert(std::is_trivially_copyable_v<ValueType>, "Only plain values can be read");
+
+			this->require_(sizeof(ValueType));
+
+			// content doesn't have to be aligned, so we can't just cast it
+			ValueType value;
+			std::memcpy(&value, this->rest_.data(), sizeof(ValueType));
+			this->rest_.remove_prefix(sizeof(ValueType));
+
+			return value;
+		}
+
+		/**
+		 * Reads string written by write_string. Returned view points into read content.
+		 */
+		std::string_view read_string() {
+			auto size = this->read<uint32_t>();
+			this->require_(size);
+
+			auto value = this->rest_.substr(0, size);
+			this->rest_.remove_prefix(size);
+
+			return value;
+		}
+
+		/**
+		 * Returns number of bytes which were not read yet
+		 */
+		size_t remaining() const {
+			return this->rest_.size();
+		}
+
+		/**
+		 * Checks if whole content was read
+		 */
+		bool finished() const {
+			return this->rest_.empty();
+		}
+	};
+}
+
+#endif //SNAPSHOTIO_H
@@ -0,0 +1,57 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <cstring>
+#include <string_view>
+
+#include "../Containers/ArenaAllocator.h"
+#include "../Containers/LinkedTable.h"
+
+namespace DataHandling {
+	/**
+	 * Stores single copy of every distinct string (interning). Interned strings are views into pool
+	 * and stay valid as long as arena of the pool exists.
+	 *
+	 * Two interned views have same content exactly when they point to the same characters,
+	 * so they can be compared by address.
+	 */
+	class StringPool {
+		using ViewAllocatorType = Containers::ArenaAllocator<std::pair<const std::string_view, std::string_view>>;
+
+		Containers::Arena& arena_;
+
+		// every interned string, mapped onto itself
+		Containers::LinkedTable<std::string_view, std::string_view, ViewAllocatorType> strings_;
+
+	public:
+		/**
+		 * Creates empty pool which stores its strings in arena
+		 */
+		explicit StringPool(Containers::Arena& arena) : arena_(arena), strings_(ViewAllocatorType(arena)) {}
+
+		StringPool(const StringPool& other) = delete;
+		StringPool& operator=(const StringPool& other) = delete;
+
+		/**
+		 * Returns pooled copy of string. String is copied into pool only the first time it is interned.
+		 *
+		 * \param value : string to be interned - it doesn't have to outlive the pool
+		 * \return view into pool with same content as value
+		 */
+		std::string_view intern(std::string_view value) {
+			if (auto existing = this->strings_.find(value)) {
+				return *existing;
+			}
+
+			auto characters = static_cast<char*>(this->arena_.allocate(value.size(), alignof(char)));
+			std::memcpy(characters, value.data(), value.size());
+
+			auto stored = std::string_view(characters, value.size());
+			this->strings_.insert(stored, stored);
+
+			return stored;
+		}
+	};
+}
+
+#endif //STRINGPOOL_H
@@ -0,0 +1,106 @@
+#ifndef YEARINDEX_H
+#define YEARINDEX_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "../Containers/ArrayList.h"
+
+namespace DataHandling {
+	/**
+	 * Maps years onto indexes of population columns. Only years which were really loaded are contained,
+	 * so there can be gaps between them (2020, 2022) - column indexes follow each other without gaps.
+	 */
+	class YearIndex {
+		// contained years in ascending order - position of year is index of its column
+		Containers::ArrayList<int> years_;
+
+		/**
+		 * Returns position of first year which is not smaller than year
+		 */
+		Containers::ArrayList<int>::ConstIterator lower_bound_(const int year) const {
+			return std::lower_bound(this->years_.begin(), this->years_.end(), year);
+		}
+
+	public:
+		/**
+		 * Creates empty index - no year is contained
+		 */
+		YearIndex() = default;
+
+		/**
+		 * Appends year, its populations will be stored in next column
+		 *
+		 * \param year : year greater than every contained year
+		 * \throw std::invalid_argument : year is not greater than last contained year
+		 */
+		void add(const int year) {
+			if (not this->years_.empty() && year <= this->last_year()) {
+				throw std::invalid_argument("Years have to be added in ascending order.");
+			}
+
+			this->years_.push_back(year);
+		}
+
+		/**
+		 * Returns first contained year. Doesn't check if index is empty.
+		 */
+		int first_year() const {
+			return this->years_[0];
+		}
+
+		/**
+		 * Returns last contained year. Doesn't check if index is empty.
+		 */
+		int last_year() const {
+			return this->years_[this->years_.size() - 1];
+		}
+
+		/**
+		 * Returns number of years in index
+		 */
+		size_t size() const {
+			return this->years_.size();
+		}
+
+		bool empty() const {
+			return this->years_.empty();
+		}
+
+		/**
+		 * Checks if every year between first and last year is contained
+		 */
+		bool is_continuous() const {
+			return this->years_.empty() || static_cast<size_t>(this->last_year() - this->first_year()) + 1 == this->years_.size();
+		}
+
+		bool contains(const int year) const {
+			auto position = this->lower_bound_(year);
+			return position != this->years_.end() && *position == year;
+		}
+
+		/**
+		 * Returns index of column which holds populations of specified year
+		 *
+		 * \throw std::out_of_range : year is not in index
+		 */
+		size_t index_of(const int year) const {
+			auto position = this->lower_bound_(year);
+			if (position == this->years_.end() || *position != year) {
+				throw std::out_of_range("Year " + std::to_string(year) + " is not loaded.");
+			}
+
+			return static_cast<size_t>(position - this->years_.begin());
+		}
+
+		/**
+		 * Returns year whose populations are stored in column with specified index
+		 */
+		int year_at(const size_t index) const {
+			return this->years_[index];
+		}
+	};
+}
+
+#endif //YEARINDEX_H
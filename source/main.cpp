@@ -1,14 +1,22 @@
 #include <iostream>
+#include <memory>
 
 #include "DataHandling/DataHolder.h"
 
 #include "ConsoleEnvironment.h"
 
 int main() {
-	// initialize holder
-	auto holder = DataHandling::DataHolder();
+	// initialize holder - without loaded data there is nothing to show
+	std::unique_ptr<DataHandling::DataHolder> holder;
+	try {
+		holder = std::make_unique<DataHandling::DataHolder>();
+	}
+	catch (std::runtime_error& e) {
+		std::cerr << "Dáta sa nepodarilo načítať: " << e.what() << std::endl;
+		return 1;
+	}
 
-	auto environment = ConsoleEnvironment(holder);
+	auto environment = ConsoleEnvironment(*holder);
 
 	environment.show_main_menu();
 	return 0;